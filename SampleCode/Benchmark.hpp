@@ -0,0 +1,172 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @file Benchmark.hpp
+ * @brief On-brain micro-benchmark harness for hot-loop timing.
+ *
+ * Tuning hue bands or stall thresholds without timing data is guessing at
+ * headroom. This harness runs a step function N times on the V5, measures
+ * each iteration's wall time with pros::micros(), and reports min / p50 /
+ * p99 / max plus a log2 jitter histogram. Two implementations can be A/B'd
+ * back-to-back in one run, which is the gate for every hot-path change in
+ * this repo: if the new variant does not win on-brain, it does not land.
+ *
+ * Results print to the PROS terminal by default; pass a FILE* (e.g. one
+ * opened on "/usd/bench.txt") to keep them on the SD card instead.
+ */
+class Benchmark
+{
+public:
+    /**
+     * @brief Iteration samples kept for percentile math (4 KB of RAM).
+     * @details Runs longer than this keep min/max/mean exact and compute
+     * percentiles over the last MAX_SAMPLES iterations.
+     */
+    static constexpr int MAX_SAMPLES = 1024;
+
+    /**
+     * @brief Buckets of the log2 jitter histogram (1 µs, 2 µs, 4 µs, ...).
+     */
+    static constexpr int HISTOGRAM_BUCKETS = 16;
+
+    /**
+     * @brief Summary statistics of one benchmarked run.
+     */
+    struct Result
+    {
+        uint32_t iterations = 0;                 // Iterations executed
+        uint32_t min_us = 0;                     // Fastest iteration
+        uint32_t p50_us = 0;                     // Median iteration
+        uint32_t p99_us = 0;                     // 99th percentile iteration
+        uint32_t max_us = 0;                     // Slowest iteration
+        double mean_us = 0.0;                    // Mean iteration time
+        uint32_t histogram[HISTOGRAM_BUCKETS] = {}; // log2 jitter histogram
+    };
+
+    /**
+     * @brief Times a step function over a number of iterations.
+     *
+     * @tparam Fn Callable taking no arguments (function pointer or lambda).
+     * @param fn The step function under test; one call = one iteration.
+     * @param iterations Iterations to run.
+     * @return Summary statistics of the run.
+     */
+    template <typename Fn>
+    static Result run(Fn fn, int iterations)
+    {
+        static uint32_t samples[MAX_SAMPLES]; // Static: keep the task stack small
+        Result result;
+        result.iterations = iterations;
+        result.min_us = UINT32_MAX;
+        uint64_t total = 0;
+        int kept = 0;
+
+        for (int i = 0; i < iterations; i++)
+        {
+            uint64_t start = pros::micros();
+            fn();
+            uint32_t elapsed = static_cast<uint32_t>(pros::micros() - start);
+
+            total += elapsed;
+            if (elapsed < result.min_us)
+            {
+                result.min_us = elapsed;
+            }
+            if (elapsed > result.max_us)
+            {
+                result.max_us = elapsed;
+            }
+            result.histogram[log2Bucket(elapsed)]++;
+            samples[kept % MAX_SAMPLES] = elapsed;
+            kept++;
+
+            // Yield occasionally so a long run does not starve other tasks
+            if ((i & 0xFF) == 0xFF)
+            {
+                pros::delay(1);
+            }
+        }
+
+        result.mean_us = iterations > 0 ? static_cast<double>(total) / iterations : 0.0;
+
+        // Percentiles over the retained window
+        int window = std::min(kept, MAX_SAMPLES);
+        if (window > 0)
+        {
+            std::sort(samples, samples + window);
+            result.p50_us = samples[window / 2];
+            result.p99_us = samples[(window * 99) / 100];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Prints a result in one compact block.
+     * @param name Label for the implementation under test.
+     * @param result The run to report.
+     * @param out Destination stream; defaults to the PROS terminal.
+     */
+    static void report(const char *name, const Result &result, FILE *out = stdout)
+    {
+        fprintf(out, "[bench] %s: n=%lu min=%lu p50=%lu p99=%lu max=%lu mean=%.2f (us)\n",
+                name,
+                static_cast<unsigned long>(result.iterations),
+                static_cast<unsigned long>(result.min_us),
+                static_cast<unsigned long>(result.p50_us),
+                static_cast<unsigned long>(result.p99_us),
+                static_cast<unsigned long>(result.max_us),
+                result.mean_us);
+        fprintf(out, "[bench] %s jitter:", name);
+        for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+        {
+            if (result.histogram[i] > 0)
+            {
+                // Bucket i holds times in [2^i, 2^(i+1)), so the exclusive
+                // upper bound of the label is the next power of two
+                fprintf(out, " <%uus:%lu", 1u << (i + 1),
+                        static_cast<unsigned long>(result.histogram[i]));
+            }
+        }
+        fprintf(out, "\n");
+    }
+
+    /**
+     * @brief A/B comparison of two implementations in one run.
+     * @details Runs A then B under identical conditions, reports both, and
+     * prints the p50 delta so the winner is unambiguous.
+     */
+    template <typename FnA, typename FnB>
+    static void compare(const char *name_a, FnA fn_a,
+                        const char *name_b, FnB fn_b,
+                        int iterations, FILE *out = stdout)
+    {
+        Result a = run(fn_a, iterations);
+        Result b = run(fn_b, iterations);
+        report(name_a, a, out);
+        report(name_b, b, out);
+        fprintf(out, "[bench] p50 %s=%luus vs %s=%luus -> %s wins\n",
+                name_a, static_cast<unsigned long>(a.p50_us),
+                name_b, static_cast<unsigned long>(b.p50_us),
+                a.p50_us <= b.p50_us ? name_a : name_b);
+    }
+
+private:
+    /**
+     * @brief Maps an iteration time to its log2 histogram bucket.
+     */
+    static int log2Bucket(uint32_t elapsed_us)
+    {
+        int bucket = 0;
+        while (elapsed_us > 1 && bucket < HISTOGRAM_BUCKETS - 1)
+        {
+            elapsed_us >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "TelemetrySnapshot.hpp"
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @file CalibrationCache.hpp
+ * @brief Binary calibration file on the SD card for instant-on tuning.
+ *
+ * Hue band offsets for the venue's lighting and the intake's spin-up/free
+ * speed envelope used to be re-derived by hand at every power-on. This cache
+ * stores them in a fixed-layout binary file: versioned header, fixed offsets,
+ * one fread to load — no text parsing, because startup has to fit inside the
+ * ~3-second window before auton and JSON parsing does not.
+ *
+ * A capture helper records live telemetry statistics while the robot runs a
+ * calibration routine (free-spin the intake; hold a reference ring at the
+ * sensor) and writes the file for the next boot.
+ */
+
+/**
+ * @brief The on-disk calibration record. Plain trivially copyable data,
+ * written and read verbatim; never reorder fields — add new ones at the end
+ * and bump VERSION.
+ */
+struct CalibrationData
+{
+    uint32_t magic = 0;          // CalibrationCache::MAGIC when valid
+    uint32_t version = 0;        // Layout version, CalibrationCache::VERSION
+    int32_t hue_offset_deg = 0;  // Per-venue hue shift for classifyHue
+    uint32_t spin_up_ms = 0;     // Measured healthy intake spin-up time
+    double free_speed_rpm = 0.0; // Measured intake free speed under no load
+    int32_t idle_current_ma = 0; // Current draw while free-running
+};
+
+/**
+ * @brief Loads and saves the calibration record in one read/write.
+ */
+class CalibrationCache
+{
+public:
+    /**
+     * @brief File identification magic: "VXCL".
+     */
+    static constexpr uint32_t MAGIC = 0x4C435856;
+
+    /**
+     * @brief Current layout version of CalibrationData.
+     */
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @brief Location of the calibration file on the SD card.
+     */
+    static constexpr const char *PATH = "/usd/calibration.bin";
+
+    /**
+     * @brief Loads the calibration in a single read.
+     *
+     * @param out Filled with the file contents on success.
+     * @return true if the file existed and its magic and version matched;
+     * on false, out is untouched and defaults should be used.
+     */
+    static bool load(CalibrationData &out)
+    {
+        FILE *file = fopen(PATH, "rb");
+        if (file == nullptr)
+        {
+            return false; // No SD card or never calibrated
+        }
+        CalibrationData data;
+        bool ok = fread(&data, sizeof(data), 1, file) == 1 &&
+                  data.magic == MAGIC &&
+                  data.version == VERSION;
+        fclose(file);
+        if (ok)
+        {
+            out = data;
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Writes the calibration file; the header fields are filled in.
+     * @return true if the file was written.
+     */
+    static bool save(CalibrationData data)
+    {
+        data.magic = MAGIC;
+        data.version = VERSION;
+        FILE *file = fopen(PATH, "wb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+        bool ok = fwrite(&data, sizeof(data), 1, file) == 1;
+        fclose(file);
+        return ok;
+    }
+};
+
+/**
+ * @brief Capture mode: accumulates live sensor statistics into a calibration
+ * record.
+ *
+ * Run a capture routine instead of a match: command the intake to full speed
+ * with nothing in it, feed every telemetry snapshot here, and call finish()
+ * once readings settle. Hue offset capture works the same way with a
+ * reference ring of known color held at the sensor: the measured mean hue
+ * minus the nominal band center becomes the venue offset.
+ */
+class CalibrationCapture
+{
+public:
+    /**
+     * @brief Feeds one telemetry snapshot while the calibration routine runs.
+     * @param nominal_hue Band-center hue (degrees) of the reference ring held
+     * at the sensor, or -1 if only the motor envelope is being captured.
+     */
+    void feed(const TelemetrySnapshot &snap, int nominal_hue = -1)
+    {
+        // Track when the motor first reaches its commanded envelope
+        if (spin_up_ms_ == 0 && snap.intake.target != 0.0 &&
+            snap.intake.velocity >= 0.8 * snap.intake.target)
+        {
+            if (start_ms_ == 0)
+            {
+                start_ms_ = snap.timestamp_ms; // First sample; no spin-up seen
+            }
+            spin_up_ms_ = snap.timestamp_ms - start_ms_;
+        }
+        if (start_ms_ == 0)
+        {
+            start_ms_ = snap.timestamp_ms;
+        }
+
+        // Free-speed and idle-current running means once up to speed
+        if (spin_up_ms_ != 0)
+        {
+            velocity_sum_ += snap.intake.velocity;
+            current_sum_ += snap.intake.current;
+            motor_samples_++;
+        }
+
+        // Venue hue offset from a reference ring of known color
+        if (nominal_hue >= 0 && snap.hue_valid)
+        {
+            hue_error_sum_ += snap.hue - nominal_hue;
+            hue_samples_++;
+        }
+    }
+
+    /**
+     * @brief Computes the record from the accumulated statistics and writes
+     * it to the SD card.
+     * @return true if the file was written.
+     */
+    bool finish() const
+    {
+        CalibrationData data;
+        data.spin_up_ms = spin_up_ms_;
+        if (motor_samples_ > 0)
+        {
+            data.free_speed_rpm = velocity_sum_ / motor_samples_;
+            data.idle_current_ma = static_cast<int32_t>(current_sum_ / motor_samples_);
+        }
+        if (hue_samples_ > 0)
+        {
+            data.hue_offset_deg = static_cast<int32_t>(-(hue_error_sum_ / hue_samples_));
+        }
+        return CalibrationCache::save(data);
+    }
+
+private:
+    uint32_t start_ms_ = 0;      // First sample timestamp
+    uint32_t spin_up_ms_ = 0;    // Measured time to the commanded envelope
+    double velocity_sum_ = 0.0;  // Velocity accumulator (post spin-up)
+    double current_sum_ = 0.0;   // Current accumulator (post spin-up)
+    uint32_t motor_samples_ = 0; // Samples in the motor accumulators
+    double hue_error_sum_ = 0.0; // Sum of (measured - nominal) hue
+    uint32_t hue_samples_ = 0;   // Samples in the hue accumulator
+};
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "pros/optical.hpp"
+#include "pros/rtos.hpp"
+
+/**
+ * @file ColorDetector.hpp
+ * @brief Adaptive high-frequency color detection engine for the V5 optical sensor.
+ *
+ * A fixed 50 ms polling loop misses rings at full intake speed: at 600 RPM a ring
+ * crosses the optical sensor window in under 40 ms. This detector instead runs a
+ * two-rate sampling scheme driven by the sensor's proximity channel:
+ *
+ *  - While nothing is near the sensor it idles at a relaxed polling period.
+ *  - As soon as proximity rises above a threshold it drops into a 1-2 ms burst
+ *    mode and samples hue at high frequency until the object passes.
+ *
+ * Detection latency is therefore bounded by the sensor's integration time rather
+ * than the task's loop period, and the measured worst-case latency (proximity
+ * rise to hue-ready) is exposed for verification on hardware.
+ */
+
+class ColorDetector
+{
+public:
+    /**
+     * @brief Polling period (ms) while no object is near the sensor.
+     */
+    static constexpr int IDLE_PERIOD_MS = 10;
+
+    /**
+     * @brief Polling period (ms) while an object is inside the sensor window.
+     */
+    static constexpr int BURST_PERIOD_MS = 1;
+
+    /**
+     * @brief Proximity reading (0-255) above which an object is considered present.
+     * @details Tune on the robot: read raw proximity with a ring held at the
+     * intake's actual pass-by distance and pick a value comfortably below it.
+     */
+    static constexpr int PROXIMITY_THRESHOLD = 100;
+
+    /**
+     * @brief Constructs a detector around an existing optical sensor.
+     * @param sensor The optical sensor watching the intake path.
+     */
+    explicit ColorDetector(pros::Optical &sensor)
+        : sensor_(sensor)
+    {
+        // Sensor configuration happens lazily in ensureConfigured(): this
+        // constructor runs during static initialization of the sample's
+        // globals, before the device is guaranteed to answer.
+    }
+
+    /**
+     * @brief Samples the sensor once; call this every loop iteration.
+     *
+     * Cheap when idle (a single proximity read), and only performs the hue
+     * transaction while an object is actually in front of the sensor.
+     *
+     * @return true if a fresh hue sample for a present object is available.
+     */
+    bool poll()
+    {
+        ensureConfigured();
+        int proximity = sensor_.get_proximity();
+        if (!updatePresence(proximity))
+        {
+            return false;
+        }
+
+        // Object present: read hue and record the detection latency
+        recordSample(sensor_.get_hue());
+        return true;
+    }
+
+    /**
+     * @brief Detection step fed from an externally collected sample.
+     *
+     * Identical logic to poll(), but consumes proximity and hue that were
+     * already read (e.g. from the telemetry snapshot), so the caller's hot
+     * path performs zero device transactions.
+     *
+     * Presence tracking always runs, even when the hue is not fresh: the
+     * falling edge is what ends burst mode and closes the latency clock,
+     * so it must never be gated on hue validity. A stale hue is simply
+     * neither recorded nor reported as a detection.
+     *
+     * @param proximity Proximity reading (0-255) from the shared sample.
+     * @param hue Hue reading (degrees) from the same sample.
+     * @param hue_fresh Whether the hue is a valid reading from this sample
+     * (e.g. TelemetrySnapshot::hue_valid), rather than a stale leftover.
+     * @return true if the sample shows a present object with a fresh hue.
+     */
+    bool poll(int proximity, double hue, bool hue_fresh = true)
+    {
+        ensureConfigured();
+        bool present = updatePresence(proximity);
+        if (!present || !hue_fresh)
+        {
+            return false;
+        }
+        recordSample(hue);
+        return true;
+    }
+
+    /**
+     * @brief Hue (degrees, 0-359) of the most recent sample taken while an
+     * object was present. Only meaningful after poll() returned true.
+     */
+    double hue() const
+    {
+        return last_hue_;
+    }
+
+    /**
+     * @brief The loop delay (ms) the caller should use until the next poll().
+     * @details Returns the burst period while an object is in the window so the
+     * consuming task tightens its own cadence, and the idle period otherwise.
+     */
+    int recommendedDelayMs() const
+    {
+        return bursting_ ? BURST_PERIOD_MS : IDLE_PERIOD_MS;
+    }
+
+    /**
+     * @brief Detection latency (µs) of the most recent object: proximity rise
+     * to first hue sample.
+     */
+    uint32_t lastDetectionLatencyUs() const
+    {
+        return last_latency_us_;
+    }
+
+    /**
+     * @brief Worst-case detection latency (µs) observed since construction.
+     * @details Print this after a practice run to verify the engine actually
+     * bounds latency by sensor integration time on your hardware.
+     */
+    uint32_t worstCaseLatencyUs() const
+    {
+        return worst_latency_us_;
+    }
+
+private:
+    /**
+     * @brief Applies the sensor configuration once the device answers.
+     * @details A failed configuration call is not benign: the sensor then
+     * runs at its default integration time with the LED off, which quietly
+     * defeats the bounded-latency claim this engine is built on. Both calls
+     * are checked and retried on every poll until they succeed, so a sensor
+     * that comes up late is configured on the first poll that reaches it.
+     */
+    void ensureConfigured()
+    {
+        if (configured_)
+        {
+            return;
+        }
+        // Minimize the sensor's own integration window so hue readings settle
+        // as fast as the hardware allows (3 ms is the documented minimum).
+        bool ok = sensor_.set_integration_time(3) != PROS_ERR;
+        // The detection LED dramatically stabilizes hue readings under arena lighting.
+        ok = sensor_.set_led_pwm(100) != PROS_ERR && ok;
+        configured_ = ok;
+    }
+
+    /**
+     * @brief Tracks object presence edges and the burst-mode latency clock.
+     * @return true if an object is currently in the sensor window.
+     */
+    bool updatePresence(int proximity)
+    {
+        bool object_present = proximity >= PROXIMITY_THRESHOLD;
+
+        if (object_present && !bursting_)
+        {
+            // Rising edge: an object just entered the window. Start the
+            // latency clock and switch to burst-rate sampling.
+            bursting_ = true;
+            burst_start_us_ = pros::micros();
+        }
+        else if (!object_present && bursting_)
+        {
+            // Falling edge: object has passed, relax back to idle rate.
+            bursting_ = false;
+        }
+        return object_present;
+    }
+
+    /**
+     * @brief Stores a hue sample and updates the latency statistics measured
+     * from the proximity rising edge to this sample.
+     */
+    void recordSample(double hue)
+    {
+        last_hue_ = hue;
+        uint32_t latency = static_cast<uint32_t>(pros::micros() - burst_start_us_);
+        last_latency_us_ = latency;
+        if (latency > worst_latency_us_)
+        {
+            worst_latency_us_ = latency;
+        }
+    }
+
+    pros::Optical &sensor_;
+    bool configured_ = false;      // Sensor configuration has been applied
+    bool bursting_ = false;        // True while an object is inside the sensor window
+    uint64_t burst_start_us_ = 0;  // Timestamp of the proximity rising edge
+    double last_hue_ = 0.0;        // Most recent hue sample
+    uint32_t last_latency_us_ = 0; // Latency of the most recent detection
+    uint32_t worst_latency_us_ = 0; // Worst latency seen since boot
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "pros/misc.hpp"
+#include <cstdint>
+
+/**
+ * @file ControllerInput.hpp
+ * @brief Debounced edge-detection input layer: one controller pass per
+ * cycle, all button edges from one XOR, handlers dispatched on edges.
+ *
+ * Polling pros::controller_get_digital_new_press per button per loop
+ * iteration grows into a chain of API calls as buttons are added, and a
+ * 20 ms opcontrol loop quantizes input latency on top of the radio's own
+ * cadence. This service instead snapshots every digital button into one
+ * 16-bit state word per poll, computes all edges in a single XOR against
+ * the previous word, and dispatches the registered handlers for the bits
+ * that changed — O(1) edge detection regardless of how many buttons are
+ * bound, polled at the radio packet period so input-to-action latency is
+ * bounded by the radio, not by a control loop.
+ *
+ * A two-sample debounce is applied before edge detection: a bit must read
+ * the same on two consecutive polls to change the accepted state, so one
+ * corrupted packet cannot fire a phantom toggle.
+ *
+ * Handlers run on the scheduler task that calls pollStep and must follow
+ * its rules: non-blocking, no sleeping. Register bindings before the poll
+ * step starts running.
+ */
+class ControllerInput
+{
+public:
+    /**
+     * @brief Poll period (ms): matches the controller radio packet cadence,
+     * so polling faster would only re-read the same packet.
+     */
+    static constexpr uint32_t POLL_PERIOD_MS = 10;
+
+    /**
+     * @brief Maximum number of registered bindings.
+     */
+    static constexpr int MAX_BINDINGS = 16;
+
+    /**
+     * @brief Which transition of the button fires the handler.
+     */
+    enum Edge
+    {
+        EDGE_PRESS,  // Released -> pressed
+        EDGE_RELEASE // Pressed -> released
+    };
+
+    /**
+     * @brief A non-blocking edge handler.
+     */
+    using Handler = void (*)();
+
+    /**
+     * @brief @param controller The controller to poll; not owned.
+     */
+    explicit ControllerInput(pros::Controller *controller)
+        : controller_(controller)
+    {
+    }
+
+    /**
+     * @brief Binds a handler to one edge of one button.
+     * @return Binding index, or -1 if the table is full.
+     */
+    int bind(pros::controller_digital_e_t button, Edge edge, Handler fn)
+    {
+        if (count_ >= MAX_BINDINGS)
+        {
+            return -1;
+        }
+        Binding &binding = bindings_[count_];
+        binding.mask = buttonBit(button);
+        binding.edge = edge;
+        binding.fn = fn;
+        return count_++;
+    }
+
+    /**
+     * @brief One input iteration: snapshot, debounce, edge-detect, dispatch.
+     * Register on the poll scheduler at POLL_PERIOD_MS.
+     */
+    void pollStep()
+    {
+        // One pass over the controller: every digital button into one word
+        uint16_t raw = 0;
+        for (int i = 0; i < BUTTON_COUNT; i++)
+        {
+            pros::controller_digital_e_t button =
+                static_cast<pros::controller_digital_e_t>(pros::E_CONTROLLER_DIGITAL_L1 + i);
+            if (controller_->get_digital(button))
+            {
+                raw |= static_cast<uint16_t>(1u << i);
+            }
+        }
+
+        // Two-sample debounce: only bits identical across consecutive polls
+        // may update the accepted state
+        uint16_t stable = static_cast<uint16_t>(~(raw ^ raw_prev_));
+        uint16_t accepted = static_cast<uint16_t>((state_ & ~stable) | (raw & stable));
+        raw_prev_ = raw;
+
+        // All edges for all buttons in one XOR
+        uint16_t edges = static_cast<uint16_t>(accepted ^ state_);
+        uint16_t pressed = static_cast<uint16_t>(edges & accepted);
+        uint16_t released = static_cast<uint16_t>(edges & state_);
+        state_ = accepted;
+        if (edges == 0)
+        {
+            return; // The common case: nothing changed, nothing to dispatch
+        }
+
+        for (int i = 0; i < count_; i++)
+        {
+            const Binding &binding = bindings_[i];
+            uint16_t fired = binding.edge == EDGE_PRESS ? pressed : released;
+            if ((fired & binding.mask) != 0)
+            {
+                binding.fn();
+            }
+        }
+    }
+
+    /**
+     * @brief Debounced pressed state of one button, for code that wants
+     * level rather than edge.
+     */
+    bool isPressed(pros::controller_digital_e_t button) const
+    {
+        return (state_ & buttonBit(button)) != 0;
+    }
+
+private:
+    /**
+     * @brief The digital buttons are a contiguous enum range; 12 of them.
+     */
+    static constexpr int BUTTON_COUNT =
+        pros::E_CONTROLLER_DIGITAL_A - pros::E_CONTROLLER_DIGITAL_L1 + 1;
+
+    /**
+     * @brief One registered edge-to-handler binding.
+     */
+    struct Binding
+    {
+        uint16_t mask; // Bit of the bound button
+        Edge edge;     // Which transition fires
+        Handler fn;    // The handler to dispatch
+    };
+
+    /**
+     * @brief State-word bit for a button.
+     */
+    static constexpr uint16_t buttonBit(pros::controller_digital_e_t button)
+    {
+        return static_cast<uint16_t>(1u << (button - pros::E_CONTROLLER_DIGITAL_L1));
+    }
+
+    pros::Controller *controller_;  // Polled controller; not owned
+    Binding bindings_[MAX_BINDINGS] = {}; // Fixed binding table; no heap
+    int count_ = 0;                 // Registered bindings
+    uint16_t raw_prev_ = 0;         // Previous raw snapshot (debounce input)
+    uint16_t state_ = 0;            // Accepted (debounced) button state
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file DeviceHealth.hpp
+ * @brief Per-device liveness tracking with off-hot-path reconnect probing.
+ *
+ * When a device cable pops out mid-match (it happens), its reads start
+ * returning PROS_ERR after an internal timeout — and a loop that keeps
+ * reading a dead port pays that timeout on every iteration, stalling
+ * everything else on the shared serial bus. This tracker turns the failure
+ * into a cheap state machine: every read through the telemetry collector
+ * reports success or failure here, a short error streak marks the device
+ * dead (one flaky read does not), and a dead device is then read only as a
+ * periodic reconnect probe instead of on every cycle. The first successful
+ * probe marks it alive again and full-rate collection resumes by itself.
+ *
+ * The consumers see the outcome through the snapshot's per-device ok flags:
+ * the sorter degrades to pass-through (no detections, intake keeps running)
+ * within one collection cycle of the sensor dying, and the stall monitor
+ * stops judging a motor it cannot actually see.
+ */
+class DeviceHealth
+{
+public:
+    /**
+     * @brief Consecutive failed reads before the device is declared dead.
+     * @details One transient error is tolerated; a cable that is out fails
+     * every read, so the streak trips within a couple of cycles.
+     */
+    static constexpr int ERROR_STREAK_LIMIT = 3;
+
+    /**
+     * @brief Period (ms) between reconnect probes while the device is dead.
+     * @details Fast enough that a re-seated cable is back in the loop within
+     * a quarter second, slow enough that the dead port's read timeouts no
+     * longer matter to the bus.
+     */
+    static constexpr uint32_t PROBE_PERIOD_MS = 250;
+
+    /**
+     * @brief Whether the device is currently considered connected.
+     */
+    bool alive() const
+    {
+        return alive_;
+    }
+
+    /**
+     * @brief Whether the collector should read the device this cycle: always
+     * while alive, and once per PROBE_PERIOD_MS as a reconnect probe while
+     * dead.
+     */
+    bool shouldRead(uint32_t now_ms)
+    {
+        if (alive_)
+        {
+            return true;
+        }
+        if (now_ms - last_probe_ms_ >= PROBE_PERIOD_MS)
+        {
+            last_probe_ms_ = now_ms;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Reports the outcome of one read.
+     * @details A success clears the streak and instantly revives a dead
+     * device; failures accumulate toward ERROR_STREAK_LIMIT.
+     */
+    void recordRead(bool ok, uint32_t now_ms)
+    {
+        if (ok)
+        {
+            error_streak_ = 0;
+            alive_ = true;
+            return;
+        }
+        if (error_streak_ < ERROR_STREAK_LIMIT)
+        {
+            error_streak_++;
+        }
+        if (error_streak_ >= ERROR_STREAK_LIMIT && alive_)
+        {
+            alive_ = false;
+            last_probe_ms_ = now_ms; // Start the probe clock from the death
+        }
+    }
+
+private:
+    int error_streak_ = 0;        // Consecutive failed reads
+    bool alive_ = true;           // Current liveness verdict
+    uint32_t last_probe_ms_ = 0;  // Timestamp of the last reconnect probe
+};
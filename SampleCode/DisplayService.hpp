@@ -0,0 +1,170 @@
+#pragma once
+
+#include "pros/llemu.hpp"
+#include "pros/misc.hpp"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @file DisplayService.hpp
+ * @brief Rate-limited, dirty-flag display writer for controller and brain LCD.
+ *
+ * Controller screen writes travel over the VEXnet radio link, are rate-limited
+ * to roughly one write per 50 ms, and each set_text call can block the calling
+ * task — latency we were paying inside the exact loop that decides ejection
+ * timing. Brain LCD prints are cheaper but still screen transactions.
+ *
+ * This service decouples producing text from pushing it: tasks write strings
+ * into a small in-memory cell model (one cell per line, with a dirty flag set
+ * only when the text actually changed), and a low-priority flusher callback
+ * pushes changed lines at the radio's allowed cadence. Hot paths never touch
+ * the screen, and unchanged text never costs a transaction — repeating
+ * "No Ring!" every 2 ms becomes free.
+ */
+class DisplayService
+{
+public:
+    /**
+     * @brief Period (ms) of the flusher callback; matches the radio's
+     * roughly one-write-per-50 ms controller screen limit.
+     */
+    static constexpr uint32_t FLUSH_PERIOD_MS = 50;
+
+    /**
+     * @brief Text lines on the controller screen.
+     */
+    static constexpr int CONTROLLER_LINES = 3;
+
+    /**
+     * @brief Text lines on the brain LCD (llemu).
+     */
+    static constexpr int BRAIN_LINES = 8;
+
+    /**
+     * @brief Characters per controller line, including the terminator; the
+     * controller screen shows about 19 characters.
+     */
+    static constexpr int CONTROLLER_LINE_LEN = 20;
+
+    /**
+     * @brief Characters per brain line, including the terminator; the brain
+     * LCD fits roughly twice what the controller does, and truncating to
+     * the controller width silently drops the values the lines exist to
+     * show (counts, attempts).
+     */
+    static constexpr int BRAIN_LINE_LEN = 40;
+
+    /**
+     * @brief Creates the service.
+     * @param controller The controller whose screen to drive, or nullptr if
+     * this program only uses the brain LCD.
+     */
+    explicit DisplayService(pros::Controller *controller)
+        : controller_(controller)
+    {
+    }
+
+    /**
+     * @brief Writes a formatted line to the controller screen cell model.
+     * @details Returns immediately; the flusher pushes the line later and
+     * only if the text actually changed. Safe on hot paths.
+     */
+    void controllerPrintf(int line, const char *fmt, ...)
+    {
+        if (line < 0 || line >= CONTROLLER_LINES)
+        {
+            return;
+        }
+        char text[CONTROLLER_LINE_LEN];
+        va_list args;
+        va_start(args, fmt);
+        vsnprintf(text, sizeof(text), fmt, args);
+        va_end(args);
+        updateCell(controller_cells_[line], text);
+    }
+
+    /**
+     * @brief Writes a formatted line to the brain LCD cell model.
+     * @details Same contract as controllerPrintf: no screen transaction here.
+     */
+    void brainPrintf(int line, const char *fmt, ...)
+    {
+        if (line < 0 || line >= BRAIN_LINES)
+        {
+            return;
+        }
+        char text[BRAIN_LINE_LEN];
+        va_list args;
+        va_start(args, fmt);
+        vsnprintf(text, sizeof(text), fmt, args);
+        va_end(args);
+        updateCell(brain_cells_[line], text);
+    }
+
+    /**
+     * @brief Pushes dirty lines to the screens; register on the scheduler at
+     * FLUSH_PERIOD_MS.
+     * @details At most one controller line is sent per flush to respect the
+     * radio rate limit; remaining dirty lines go out on later flushes. All
+     * dirty brain lines are flushed in one pass.
+     */
+    void flushStep()
+    {
+        // Controller: one line per flush, round-robin so every line gets a turn
+        if (controller_ != nullptr)
+        {
+            for (int i = 0; i < CONTROLLER_LINES; i++)
+            {
+                int line = (next_controller_line_ + i) % CONTROLLER_LINES;
+                if (controller_cells_[line].dirty)
+                {
+                    controller_->set_text(line, 0, controller_cells_[line].text);
+                    controller_cells_[line].dirty = false;
+                    next_controller_line_ = (line + 1) % CONTROLLER_LINES;
+                    break;
+                }
+            }
+        }
+
+        // Brain LCD: flush every dirty line in one batch
+        for (int line = 0; line < BRAIN_LINES; line++)
+        {
+            if (brain_cells_[line].dirty)
+            {
+                pros::lcd::print(line, "%s", brain_cells_[line].text);
+                brain_cells_[line].dirty = false;
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief One line of the cell model, sized for its target screen.
+     */
+    template <int Len>
+    struct Cell
+    {
+        char text[Len] = ""; // Last written text
+        bool dirty = false;  // True if text changed since the last flush
+    };
+
+    /**
+     * @brief Stores new text in a cell, marking it dirty only on change.
+     */
+    template <int Len>
+    static void updateCell(Cell<Len> &cell, const char *text)
+    {
+        if (strncmp(cell.text, text, Len) != 0)
+        {
+            strncpy(cell.text, text, Len - 1);
+            cell.text[Len - 1] = '\0';
+            cell.dirty = true;
+        }
+    }
+
+    pros::Controller *controller_;             // Target controller, or nullptr
+    Cell<CONTROLLER_LINE_LEN> controller_cells_[CONTROLLER_LINES]; // Controller screen cell model
+    Cell<BRAIN_LINE_LEN> brain_cells_[BRAIN_LINES];                // Brain LCD cell model
+    int next_controller_line_ = 0;             // Round-robin cursor for flushes
+};
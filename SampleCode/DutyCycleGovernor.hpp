@@ -0,0 +1,157 @@
+#pragma once
+
+#include "PollScheduler.hpp"
+#include "IntakeSupervisor.hpp"
+#include <cstdint>
+
+/**
+ * @file DutyCycleGovernor.hpp
+ * @brief Scales scheduler polling rates with robot activity.
+ *
+ * Every polling callback in these samples runs at a rate chosen for the
+ * busy case — and keeps running at it while the robot sits still. A stall
+ * monitor sampling a motor whose target velocity is zero learns nothing;
+ * full-rate telemetry of an idle intake is serial-bus traffic the drive
+ * and odometry code sharing the brain would rather have. Over a long
+ * skills practice session that idle polling is also a measurable slice of
+ * brain power draw.
+ *
+ * The intent authority already knows whether the intake is supposed to be
+ * doing anything (see IntakeSupervisor). This governor subscribes to that
+ * intent and applies it to registered scheduler slots: while any intent is
+ * active the slot runs at its full rate, and while the intent is IDLE the
+ * slot is either dropped to a deep-idle period or disabled outright. The
+ * return to full rate is immediate — the governor polls intent at
+ * STEP_PERIOD_MS and PollScheduler::setPeriod pulls a pending deadline in
+ * when the period shrinks, so the first active-rate run happens within one
+ * governor step of the start edge, not after the idle interval expires.
+ *
+ * Do not govern the slot that produces the activity signal: controller
+ * input must poll at full rate while idle, because a button press is
+ * exactly how the robot stops being idle. A slot disabled explicitly
+ * through the scheduler stays off only until the next idle-to-active
+ * edge re-applies governance; slots with an independent lifecycle should
+ * not be registered here.
+ */
+class DutyCycleGovernor
+{
+public:
+    /**
+     * @brief Period (ms) of the intent-polling step, and therefore the
+     * worst-case ramp-up latency after a start edge.
+     */
+    static constexpr uint32_t STEP_PERIOD_MS = 20;
+
+    /**
+     * @brief Deep-idle period (ms) for slots that stay alive while idle.
+     * @details Slow enough that idle polling stops mattering to the bus,
+     * fast enough that the telemetry snapshot never goes truly stale.
+     */
+    static constexpr uint32_t IDLE_PERIOD_MS = 100;
+
+    /**
+     * @brief Maximum number of governed slots.
+     */
+    static constexpr int MAX_SLOTS = 8;
+
+    /**
+     * @brief @param scheduler The scheduler whose slots are governed.
+     * @param supervisor The intent authority providing the activity signal.
+     */
+    DutyCycleGovernor(PollScheduler *scheduler, IntakeSupervisor *supervisor)
+        : scheduler_(scheduler), supervisor_(supervisor)
+    {
+    }
+
+    /**
+     * @brief Registers a scheduler slot for governance and applies the
+     * current activity state to it immediately.
+     *
+     * @param handle The scheduler handle to govern.
+     * @param active_period_ms Period while any intent is active.
+     * @param idle_period_ms Period while idle, or 0 to disable the slot
+     * entirely until the next start edge.
+     * @return Governed-slot index, or -1 if the handle is invalid or the
+     * table is full.
+     */
+    int govern(int handle, uint32_t active_period_ms, uint32_t idle_period_ms)
+    {
+        if (handle < 0 || count_ >= MAX_SLOTS)
+        {
+            return -1;
+        }
+        Governed &slot = slots_[count_];
+        slot.handle = handle;
+        slot.active_ms = active_period_ms;
+        slot.idle_ms = idle_period_ms;
+        apply(slot, active_); // Adopt the current state, not the next edge
+        return count_++;
+    }
+
+    /**
+     * @brief Whether the robot is currently considered active, for steps
+     * that tune their own period and need to pick the idle rate themselves.
+     */
+    bool active() const
+    {
+        return active_;
+    }
+
+    /**
+     * @brief One governance iteration: re-applies the slot rates when the
+     * activity state changes. Register on the scheduler at STEP_PERIOD_MS.
+     */
+    void step()
+    {
+        bool active = supervisor_->intent() != INTENT_IDLE;
+        if (active == active_)
+        {
+            return; // The common case: no edge, nothing to re-apply
+        }
+        active_ = active;
+        for (int i = 0; i < count_; i++)
+        {
+            apply(slots_[i], active);
+        }
+    }
+
+private:
+    /**
+     * @brief One governed scheduler slot and its two rates.
+     */
+    struct Governed
+    {
+        int handle;         // Scheduler handle
+        uint32_t active_ms; // Period while any intent is active
+        uint32_t idle_ms;   // Period while idle; 0 disables the slot
+    };
+
+    /**
+     * @brief Applies one activity state to one slot.
+     * @details The active path re-enables as well as re-rates, so a slot
+     * parked with idle_ms = 0 comes back on the start edge; re-enabling
+     * resets its deadline to "due now" for the instant first run.
+     */
+    void apply(const Governed &slot, bool active)
+    {
+        if (active)
+        {
+            scheduler_->setPeriod(slot.handle, slot.active_ms);
+            scheduler_->setEnabled(slot.handle, true);
+        }
+        else if (slot.idle_ms == 0)
+        {
+            scheduler_->setEnabled(slot.handle, false);
+        }
+        else
+        {
+            scheduler_->setPeriod(slot.handle, slot.idle_ms);
+        }
+    }
+
+    PollScheduler *scheduler_;     // Governed scheduler; not owned
+    IntakeSupervisor *supervisor_; // Activity signal source; not owned
+    Governed slots_[MAX_SLOTS] = {}; // Fixed slot table; no heap
+    int count_ = 0;                // Registered governed slots
+    bool active_ = false;          // Intent starts out INTENT_IDLE
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file FixedPoint.hpp
+ * @brief Q16.16 fixed-point arithmetic for the per-millisecond hot loops.
+ *
+ * The V5's Cortex-A9 has a real FPU, so the double math in the shipping
+ * paths is fine there — but the same detection logic gets ported to
+ * coprocessor boards without one, and at per-millisecond sample volumes the
+ * soft-float conversion cost is real. This type is the drop-in integer
+ * alternative: 16 integer bits, 16 fractional bits, all arithmetic in plain
+ * int32/int64 operations.
+ *
+ * Range is ±32768 with ~1.5e-5 resolution, which covers every quantity the
+ * samples compute on directly (hue 0-360, velocity ±600 RPM, fractions).
+ * Overflowing operations saturate to the range limits instead of wrapping —
+ * the embedded-DSP convention — so a blown intermediate (e.g. the variance
+ * accumulator under extreme sample spread) degrades to a pessimistic bound
+ * rather than garbage.
+ *
+ * The hot-loop building blocks (HueSampleBuffer, the stall detector's
+ * envelope check) take their arithmetic type as a template parameter
+ * defaulting to double; instantiate them with Fixed to select this path and
+ * A/B the two with the benchmark target.
+ */
+class Fixed
+{
+public:
+    /**
+     * @brief Fractional bits; one unit is 1/65536.
+     */
+    static constexpr int FRACTION_BITS = 16;
+
+    /**
+     * @brief Zero-initialized by default, like the built-in types.
+     */
+    constexpr Fixed() : raw_(0) {}
+
+    /**
+     * @brief Converts from an integer count or threshold.
+     */
+    constexpr explicit Fixed(int value) : raw_(saturate(static_cast<int64_t>(value) << FRACTION_BITS)) {}
+
+    /**
+     * @brief Converts from a double, e.g. a tuning constant; usable in
+     * constexpr context so constants fold at compile time.
+     */
+    static constexpr Fixed fromDouble(double value)
+    {
+        return fromRaw(saturate(static_cast<int64_t>(value * ONE + (value >= 0 ? 0.5 : -0.5))));
+    }
+
+    /**
+     * @brief Converts back to double, e.g. for display output off the hot path.
+     */
+    constexpr double toDouble() const
+    {
+        return static_cast<double>(raw_) / ONE;
+    }
+
+    constexpr Fixed operator-() const
+    {
+        return fromRaw(saturate(-static_cast<int64_t>(raw_)));
+    }
+
+    constexpr Fixed operator+(Fixed other) const
+    {
+        return fromRaw(saturate(static_cast<int64_t>(raw_) + other.raw_));
+    }
+
+    constexpr Fixed operator-(Fixed other) const
+    {
+        return fromRaw(saturate(static_cast<int64_t>(raw_) - other.raw_));
+    }
+
+    constexpr Fixed operator*(Fixed other) const
+    {
+        // 32x32 -> 64-bit product, shifted back down to Q16.16
+        return fromRaw(saturate((static_cast<int64_t>(raw_) * other.raw_) >> FRACTION_BITS));
+    }
+
+    constexpr Fixed operator/(Fixed other) const
+    {
+        // Pre-shift the dividend so the quotient keeps its fractional bits
+        return other.raw_ != 0
+                   ? fromRaw(saturate((static_cast<int64_t>(raw_) << FRACTION_BITS) / other.raw_))
+                   : fromRaw(raw_ >= 0 ? RAW_MAX : RAW_MIN);
+    }
+
+    Fixed &operator+=(Fixed other)
+    {
+        *this = *this + other;
+        return *this;
+    }
+
+    Fixed &operator-=(Fixed other)
+    {
+        *this = *this - other;
+        return *this;
+    }
+
+    constexpr bool operator<(Fixed other) const { return raw_ < other.raw_; }
+    constexpr bool operator>(Fixed other) const { return raw_ > other.raw_; }
+    constexpr bool operator<=(Fixed other) const { return raw_ <= other.raw_; }
+    constexpr bool operator>=(Fixed other) const { return raw_ >= other.raw_; }
+    constexpr bool operator==(Fixed other) const { return raw_ == other.raw_; }
+    constexpr bool operator!=(Fixed other) const { return raw_ != other.raw_; }
+
+    /**
+     * @brief The underlying Q16.16 integer, e.g. for binary logging.
+     */
+    constexpr int32_t raw() const
+    {
+        return raw_;
+    }
+
+private:
+    static constexpr double ONE = 65536.0;       // 1.0 in raw units
+    static constexpr int64_t RAW_MAX = INT32_MAX; // Saturation ceiling
+    static constexpr int64_t RAW_MIN = INT32_MIN; // Saturation floor
+
+    /**
+     * @brief Clamps a 64-bit intermediate into the representable raw range.
+     */
+    static constexpr int32_t saturate(int64_t raw)
+    {
+        return raw > RAW_MAX   ? static_cast<int32_t>(RAW_MAX)
+               : raw < RAW_MIN ? static_cast<int32_t>(RAW_MIN)
+                               : static_cast<int32_t>(raw);
+    }
+
+    static constexpr Fixed fromRaw(int32_t raw)
+    {
+        Fixed result;
+        result.raw_ = raw;
+        return result;
+    }
+
+    int32_t raw_; // Q16.16 representation
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Trace.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @file FlightRecorder.hpp
+ * @brief Match-long event store: every trace event of a match retained in a
+ * preallocated arena, dumped to the SD card in one write when disabled.
+ *
+ * The trace facility streams its ring to the SD card every 100 ms, which is
+ * fine for debugging but means a match log's completeness depends on the
+ * flusher keeping up, and the periodic fwrites share the match with the
+ * control loops. The flight recorder instead keeps the whole match in RAM:
+ * the event store is allocated once at program start, sized for the
+ * worst-case event rate over a 105-second match, and recording an event is
+ * an index increment plus a 16-byte copy — no allocation, no I/O, nothing
+ * on any hot path. When the field disables us (the PROS disabled()
+ * callback), the arena goes to /usd/flight.bin in one sequential write,
+ * which the SD card handles far better than scattered small appends.
+ *
+ * Events reuse the 16-byte TraceEvent record and arrive through the trace
+ * flusher's sink hook, so every existing trace point — classifications,
+ * ejection decisions, stall and recovery events — is captured without
+ * touching the code that emits it. Decode and diff dumps on the host with
+ * Tools/decode_flight_log.py.
+ */
+class FlightRecorder
+{
+public:
+    /**
+     * @brief Arena capacity in events (128 KB of RAM).
+     * @details Sized from the worst case we have measured: a full-rate feed
+     * with constant rejects generates under 40 events/s, and stall flapping
+     * adds bursts — 8192 events covers a 105 s match at ~75 events/s with
+     * headroom. If the arena fills, later events are dropped and counted.
+     */
+    static constexpr std::size_t CAPACITY = 8192;
+
+    /**
+     * @brief Hooks the recorder into the trace facility; call once at startup.
+     */
+    static void attach()
+    {
+        Trace::setSink(record);
+    }
+
+    /**
+     * @brief Appends a batch of events to the arena. Called by the trace
+     * flusher on the scheduler task; a 16-byte copy per event, nothing more.
+     */
+    static void record(const TraceEvent *events, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            if (used_ >= CAPACITY)
+            {
+                overflowed_++;
+                continue;
+            }
+            arena_[used_++] = events[i];
+        }
+    }
+
+    /**
+     * @brief Writes the whole arena to /usd/flight.bin in one sequential
+     * write. Call from the competition disabled() callback — the match is
+     * over, so the write cost no longer competes with control loops.
+     * @return Number of events written, 0 without an SD card.
+     */
+    static std::size_t dump()
+    {
+        if (used_ == 0)
+        {
+            return 0;
+        }
+        FILE *file = fopen("/usd/flight.bin", "wb");
+        if (file == nullptr)
+        {
+            return 0;
+        }
+        std::size_t written = fwrite(arena_, sizeof(TraceEvent), used_, file);
+        fclose(file);
+        return written;
+    }
+
+    /**
+     * @brief Events currently held in the arena.
+     */
+    static std::size_t used()
+    {
+        return used_;
+    }
+
+    /**
+     * @brief Events dropped because the arena was full; visible for telemetry.
+     */
+    static uint32_t overflowed()
+    {
+        return overflowed_;
+    }
+
+private:
+    static inline TraceEvent arena_[CAPACITY] = {}; // The whole-match store
+    static inline std::size_t used_ = 0;            // Events recorded so far
+    static inline uint32_t overflowed_ = 0;         // Events lost to a full arena
+};
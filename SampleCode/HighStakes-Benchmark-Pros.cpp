@@ -0,0 +1,156 @@
+// Your path to the pros instalation may vary, but this is the default path for a regular installation
+#include "pros/apix.h"
+#include "Benchmark.hpp"
+#include "HueLookup.hpp"
+#include "HueSampleBuffer.hpp"
+#include "FixedPoint.hpp"
+#include "StallDetector.hpp"
+
+/**
+ * @file HighStakes-Benchmark-Pros.cpp
+ * @brief Benchmark target for the hot-path building blocks in this repo.
+ *
+ * Flash this program (instead of the competition program) when you want
+ * timing numbers from real hardware. It A/B's the hue classification paths
+ * and times the smoothing buffer, then prints results to the PROS terminal.
+ * To benchmark your own step functions (e.g. an instrumented colorSortStep
+ * or intakeMonitorStep variant), copy them in here and hand them to
+ * Benchmark::run or Benchmark::compare the same way.
+ */
+
+/**
+ * @brief Iterations per benchmarked implementation.
+ * @details Large enough for stable p99 numbers; a full run takes a few
+ * seconds on the brain.
+ */
+constexpr int BENCH_ITERATIONS = 100000;
+
+/**
+ * @brief Rotating fake hue input so the branch predictor and cache see
+ * realistic variety instead of one constant value.
+ */
+int bench_hue = 0;
+
+/**
+ * @brief Sink the optimizer cannot remove results into.
+ */
+volatile int bench_sink = 0;
+
+/**
+ * @brief Branchy range-comparison classification, as detectColor originally
+ * did it. Kept here as the baseline side of the A/B.
+ */
+void benchBranchyClassify()
+{
+    int hue = bench_hue = (bench_hue + 7) % 360;
+    AllianceColor color;
+    if (hue >= 330 || hue <= 30)
+    {
+        color = RED;
+    }
+    else if (hue >= 210 && hue <= 270)
+    {
+        color = BLUE;
+    }
+    else
+    {
+        color = UNKNOWN;
+    }
+    bench_sink = color;
+}
+
+/**
+ * @brief Lookup-table classification via classifyHue, the shipping path.
+ */
+void benchTableClassify()
+{
+    int hue = bench_hue = (bench_hue + 7) % 360;
+    bench_sink = classifyHue(hue);
+}
+
+/**
+ * @brief One push plus mean read on the smoothing ring buffer.
+ */
+void benchSampleBuffer()
+{
+    static HueSampleBuffer<16> buffer;
+    bench_hue = (bench_hue + 7) % 360;
+    buffer.push(bench_hue);
+    bench_sink = static_cast<int>(buffer.mean());
+}
+
+/**
+ * @brief One push plus mean read on the Q16.16 instantiation of the
+ * smoothing buffer — the fixed-point side of the A/B.
+ */
+void benchSampleBufferFixed()
+{
+    static HueSampleBuffer<16, Fixed> buffer;
+    bench_hue = (bench_hue + 7) % 360;
+    buffer.push(Fixed(bench_hue));
+    bench_sink = buffer.mean().raw();
+}
+
+/**
+ * @brief Rotating fake velocity input for the envelope-check benchmarks.
+ */
+double bench_velocity = 0.0;
+
+/**
+ * @brief Velocity envelope check in double, the shipping V5 path.
+ */
+void benchEnvelopeDouble()
+{
+    bench_velocity = bench_velocity >= 600.0 ? 0.0 : bench_velocity + 1.0;
+    bench_sink = StallDetector::envelopeReached(bench_velocity, 600.0,
+                                                StallDetector::ARM_FRACTION);
+}
+
+/**
+ * @brief Velocity envelope check in Q16.16, the coprocessor-port path.
+ */
+void benchEnvelopeFixed()
+{
+    bench_velocity = bench_velocity >= 600.0 ? 0.0 : bench_velocity + 1.0;
+    bench_sink = StallDetector::envelopeReached(
+        Fixed(static_cast<int>(bench_velocity)), Fixed(600),
+        Fixed::fromDouble(StallDetector::ARM_FRACTION));
+}
+
+/**
+ * @brief Runs the benchmark suite once and prints the results.
+ */
+void opcontrol()
+{
+    // Let the terminal connection settle before the first printf burst
+    pros::delay(500);
+
+    printf("[bench] starting, %d iterations per variant\n", BENCH_ITERATIONS);
+
+    // A/B: the classification rework's claimed win, measured on-brain
+    Benchmark::compare("classify_branchy", benchBranchyClassify,
+                       "classify_table", benchTableClassify,
+                       BENCH_ITERATIONS);
+
+    // Single-sided: smoothing buffer cost per sample
+    Benchmark::Result buffer_result = Benchmark::run(benchSampleBuffer, BENCH_ITERATIONS);
+    Benchmark::report("hue_sample_buffer", buffer_result);
+
+    // A/B: double vs Q16.16 fixed point. On the V5's hard FPU expect a wash
+    // (or a double win); the fixed-point side matters on the FPU-less
+    // coprocessor boards this logic gets ported to.
+    Benchmark::compare("hue_buffer_double", benchSampleBuffer,
+                       "hue_buffer_fixed", benchSampleBufferFixed,
+                       BENCH_ITERATIONS);
+    Benchmark::compare("envelope_double", benchEnvelopeDouble,
+                       "envelope_fixed", benchEnvelopeFixed,
+                       BENCH_ITERATIONS);
+
+    printf("[bench] done\n");
+
+    while (true)
+    {
+        // Keep the program alive so the terminal stays readable
+        pros::delay(1000);
+    }
+}
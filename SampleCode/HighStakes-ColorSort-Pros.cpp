@@ -1,21 +1,25 @@
 // Your path to the pros instalation may vary, but this is the default path for a regular installation
 #include "pros/apix.h"
 #include "RobotConfig.hpp"
+#include "ColorDetector.hpp"
+#include "HueLookup.hpp"
+#include "HueSampleBuffer.hpp"
+#include "PollScheduler.hpp"
+#include "TelemetrySnapshot.hpp"
+#include "DisplayService.hpp"
+#include "MotorCommandQueue.hpp"
+#include "Trace.hpp"
+#include <cmath>
+#include "CalibrationCache.hpp"
+#include "Watchdog.hpp"
+#include "FlightRecorder.hpp"
+#include "IntakeSupervisor.hpp"
+#include "Replay.hpp"
+#include "DutyCycleGovernor.hpp"
 
-// The assumption is that you have defined the required objects in some other file, for example RobotConfig.hpp
-// So colorSortSensor, intake and mainController are defined
-// if you have different names, change them accordingly in the code below
-
-/**
- * @brief Enumeration of alliance colors.
- * Used to determine the robot's team color and apply related logic.
- */
-enum AllianceColor
-{
-    RED,
-    BLUE,
-    UNKNOWN
-};
+// Device objects (colorSortSensor, intake, mainController) come from the
+// compile-time configuration in RobotConfig.hpp — edit the template
+// arguments there to change ports or gearsets
 
 /**
  * @brief Global variable representing the current alliance color.
@@ -25,110 +29,506 @@ enum AllianceColor
 AllianceColor ALLIANCE_COLOR = RED;
 
 /**
- * @brief Detects the color using the colorSortSensor.
+ * @brief Alliance baked into the program image at compile time, or UNKNOWN
+ * to decide at startup.
+ * @details Set to RED or BLUE when flashing an alliance-specific image: the
+ * sorter then registers the colorSortStepFor instantiation with that color
+ * baked in, the reject decision becomes one probe of a compile-time table,
+ * and the match/mismatch branching folds away. Leave UNKNOWN for shared
+ * practice builds, where startup selects between the two pre-instantiated
+ * steps from the ALLIANCE_COLOR global (or falls back to the fully runtime
+ * instantiation if that is still UNKNOWN).
+ */
+constexpr AllianceColor COMPILED_ALLIANCE = UNKNOWN;
+
+/**
+ * @brief Detection engine wrapped around the color sorting sensor.
+ * @details Handles proximity-gated burst sampling so hue reads happen at 1 ms
+ * cadence only while a ring is actually inside the sensor window.
+ */
+ColorDetector colorDetector(colorSortSensor);
+
+/**
+ * @brief Per-venue hue calibration offset in degrees.
+ * @details Arena lighting shifts the whole hue circle; loaded from the SD
+ * calibration cache at startup (captured with CalibrationCapture), falling
+ * back to zero when no cache exists.
+ */
+int HUE_CALIBRATION_OFFSET = 0;
+
+/**
+ * @brief Classifies a hue reading as RED, BLUE, or UNKNOWN.
  *
- * Uses the hue reading to determine if the detected color is RED, BLUE, or UNKNOWN.
+ * The hue bands are declared in HueLookup.hpp and expanded into a 360-entry
+ * constexpr table at compile time, so this is a single array index on the hot
+ * path no matter how many bands are configured.
  *
+ * @param hue Hue in degrees (0-359) as reported by the optical sensor.
  * @return AllianceColor The detected color as an AllianceColor enum value.
  */
-AllianceColor detectColor()
+AllianceColor detectColor(int hue)
 {
-    int hue = colorSortSensor.get_hue();
+    return classifyHue(hue, HUE_CALIBRATION_OFFSET);
+}
 
-    if (hue >= 330 || hue <= 30)
-    {
-        return RED;
-    }
-    else if (hue >= 210 && hue <= 270)
+/**
+ * @brief States of the ejection actuator.
+ * @details Ejections used to block the task with two pros::delay calls totaling
+ * 300 ms, during which a second wrong-color ring could pass undetected. Ring
+ * travel is tracked per object in the pipeline inside colorSortStep, so this
+ * machine covers only the actuator itself: the stop window and the resume.
+ */
+enum EjectionState
+{
+    TRACKING, // Actuator idle; pipeline objects travel toward the eject position
+    EJECTING, // Intake stopped; waiting for the reject ring to fly off via inertia
+    RESUMING  // Stop window elapsed; restore normal intake speed
+};
+
+/**
+ * @brief Cooperative scheduler shared by every periodic feature in this sample.
+ * @details One task, one stack: register additional sensor-polling callbacks
+ * (e.g. a stall monitor) on this same scheduler instead of spawning tasks.
+ */
+PollScheduler pollScheduler;
+
+/**
+ * @brief Scheduler handle for the color-sort callback; -1 until registered.
+ */
+int colorSortHandle = -1;
+
+/**
+ * @brief Display service owning all screen writes for this sample.
+ * @details Hot paths write into its cell model; the flusher callback pushes
+ * only changed lines at the radio's allowed cadence.
+ */
+DisplayService display(&mainController);
+
+/**
+ * @brief Scheduler callback that flushes dirty display lines.
+ */
+void displayStep()
+{
+    display.flushStep();
+}
+
+/**
+ * @brief Supervisor for the scheduler task: counts missed deadlines, bumps
+ * priority when it is starved, and publishes the CPU/slip accounting.
+ */
+Watchdog watchdog;
+
+/**
+ * @brief Single authority over the intake motor: all features enqueue
+ * commands; only the drain step below touches the device.
+ */
+MotorOwner intakeOwner(intake);
+
+/**
+ * @brief Command channel for callbacks running on the scheduler task.
+ */
+int sorterChannel = intakeOwner.openChannel();
+
+/**
+ * @brief Command channel for the opcontrol task.
+ */
+int driverChannel = intakeOwner.openChannel();
+
+/**
+ * @brief Scheduler callback that drains queued motor commands.
+ */
+void motorOwnerStep()
+{
+    intakeOwner.drainStep();
+}
+
+/**
+ * @brief Intent authority over the intake: ejection stops and resumes go
+ * through here, so any detector in the program knows a zero velocity is
+ * commanded rather than a fault. This sample runs no stall detector; the
+ * intent is published for the day the two features share one program.
+ */
+IntakeSupervisor intakeSupervisor(&intakeOwner, sorterChannel);
+
+/**
+ * @brief Scales polling rates with intake activity: full sensor rates while
+ * the intake runs, deep idle while it is stopped.
+ */
+DutyCycleGovernor dutyGovernor(&pollScheduler, &intakeSupervisor);
+
+/**
+ * @brief Scheduler callback for the duty-cycle governor.
+ */
+void dutyGovernorStep()
+{
+    dutyGovernor.step();
+}
+
+/**
+ * @brief Shared telemetry collector: the only code that reads the intake
+ * motor's and color sensor's telemetry registers.
+ */
+TelemetryCollector telemetry(&intake, &colorSortSensor);
+
+/**
+ * @brief Scheduler handle for the telemetry collector; -1 until registered.
+ */
+int telemetryHandle = -1;
+
+/**
+ * @brief Flip to true to record every snapshot to the SD card for replay
+ * tuning (see Replay.hpp); the branch folds away when disabled.
+ */
+constexpr bool TELEMETRY_RECORD_ENABLED = false;
+
+/**
+ * @brief Scheduler callback that refreshes the telemetry snapshot.
+ * @details Runs at the device-update period while the intake path is empty
+ * and arms burst-rate collection while the proximity gate reports an object,
+ * so high-rate hue sampling only happens when there is a hue worth sampling.
+ */
+void telemetryStep()
+{
+    telemetry.collect();
+    if (TELEMETRY_RECORD_ENABLED)
     {
-        return BLUE;
+        TelemetryRecorder::feed(telemetry.read());
     }
-    else
+    uint32_t period = telemetry.objectPresent() ? TelemetryCollector::BURST_PERIOD_MS
+                                                : TelemetryCollector::COLLECT_PERIOD_MS;
+    if (!dutyGovernor.active())
     {
-        return UNKNOWN; // Define UNKNOWN in your enum if needed
+        period = DutyCycleGovernor::IDLE_PERIOD_MS; // Nothing moving, nothing to burst on
     }
+    pollScheduler.setPeriod(telemetryHandle, period);
 }
 
 /**
- * @brief Task function to handle color sorting logic.
+ * @brief One color-sorting iteration, run periodically by the scheduler.
+ *
+ * @tparam Alliance The alliance whose rings are kept, baked in at compile
+ * time — the reject decision is one probe of a per-alliance constexpr table
+ * and every match comparison folds to a constant. Instantiate with UNKNOWN
+ * to read the ALLIANCE_COLOR global each iteration instead (the fallback
+ * for shared practice builds).
+ *
+ * Monitors objects detected by the color sorting sensor, determines whether
+ * each one matches the ALLIANCE_COLOR, and controls the intake motor to allow
+ * or reject it. Every classified ring — accepted or rejected — enters a
+ * fixed-size tracking pipeline stamped with its color, detection time, and
+ * intake encoder position; the ejection actuator is scheduled per object as
+ * it reaches the eject position. At a 600 RPM feed rate rings arrive ~150 ms
+ * apart, so several are between the sensor and the eject position at once:
+ * the pipeline lets a match ring and a reject ring be in flight
+ * simultaneously instead of serializing one full ejection sequence per ring.
  *
- * This function continuously monitors objects detected by the color sorting sensor.
- * It determines whether the detected object matches the ALLIANCE_COLOR and
- * controls the intake motor to either allow or reject the object.
- * This function should be run as a separate task to avoid blocking the main loop.
+ * Runs on the shared scheduler stack: it must never sleep or busy-wait, so
+ * all state persists in function-local statics between invocations.
  */
-void colorSortTask()
+template <AllianceColor Alliance>
+void colorSortStepFor()
 {
     // Constants for motor behavior during color sorting
-    constexpr int TRAVEL_DELAY = 100; // Delay (ms) before stopping to eject
-    constexpr int STOP_DELAY = 200;   // Delay (ms) to ensure ejection
-    constexpr int INTAKE_SPEED = 100; // Default motor speed for intake
+    constexpr double TRAVEL_DEGREES = 180.0; // Intake rotation (deg) from sensor to eject position
+    constexpr int STOP_REFERENCE_MS = 200;   // Stop window (ms) at the 300 RPM reference speed
+    constexpr double REFERENCE_RPM = 300.0;  // Intake speed the stop window is tuned at
+    constexpr int STOP_MIN_MS = 80;          // Floor: ring still needs time to fly clear
+    constexpr int STOP_MAX_MS = 300;         // Ceiling for crawling intake speeds
+    constexpr int TRAVEL_TIMEOUT = 1000;     // Abandon an ejection whose ring never travels (ms)
+    constexpr int INTAKE_SPEED = 100;        // Default motor speed for intake
+    constexpr int MAX_TRACKED_OBJECTS = 8;   // Rings tracked between sensor and eject position
 
-    while (true)
+    // Minimum burst samples to accumulate before classifying a ring. At the
+    // 1 ms burst rate this adds only a few ms of latency and debounces
+    // single-sample noise from arena lighting.
+    constexpr std::size_t MIN_HUE_SAMPLES = 4;
+
+    static EjectionState state = TRACKING; // Current actuator phase
+
+    // Rolling hue statistics for the ring currently in the sensor window.
+    // 16 samples at the 1 ms burst rate spans a ring's whole pass-by.
+    static HueSampleBuffer<16> hue_samples;
+
+    // One tracked ring in the pipeline: its classified color, when it was
+    // detected (for the travel timeout), and where the intake encoder stood
+    // at detection (for travel distance).
+    struct TrackedObject
     {
-        // Detect the current color of the object using the sensor
-        AllianceColor detectedColor = detectColor();
+        AllianceColor color;      // Classification result
+        uint32_t detected_ms;     // Detection timestamp
+        double detected_position; // Intake encoder position at detection (deg)
+    };
 
-        // Scenario 1: Detected color matches the alliance color
-        if (detectedColor == ALLIANCE_COLOR)
+    // Fixed-size FIFO of every ring between the sensor and the eject
+    // position, accepted and rejected alike. Head/tail indices wrap; the
+    // queue is only touched from this callback.
+    static TrackedObject pipeline[MAX_TRACKED_OBJECTS];
+    static int pipeline_head = 0;  // Oldest tracked ring
+    static int pipeline_count = 0; // Number of rings in flight
+
+    static TrackedObject active = {};  // The ring the actuator is ejecting
+    static uint32_t stop_deadline = 0; // When the adaptive stop window ends (ms)
+
+    static bool ring_in_window = false;  // Latched while one ring sits in the sensor window
+    static bool ring_classified = false; // Set once the current ring has been classified
+
+    // The color we keep: a compile-time constant in the baked
+    // instantiations, the runtime global in the UNKNOWN fallback
+    const AllianceColor target = Alliance != UNKNOWN ? Alliance : ALLIANCE_COLOR;
+
+    uint32_t now = pros::millis();
+
+    // One coherent device sample for this iteration; zero device calls here
+    TelemetrySnapshot snap = telemetry.read();
+
+    // --- Detection: runs every iteration, even mid-ejection -------------
+    // Presence always feeds the detector so burst mode ends on the falling
+    // edge; hue_valid keeps a stale hue (failed hue read) from entering
+    // the statistics or driving a classification
+    if (colorDetector.poll(snap.proximity, snap.hue, snap.hue_valid))
+    {
+        if (!ring_in_window)
+        {
+            // New ring entering the window: start fresh statistics
+            ring_in_window = true;
+            ring_classified = false;
+            hue_samples.clear();
+        }
+
+        // Every burst sample feeds the rolling statistics in O(1)
+        hue_samples.push(snap.hue);
+
+        // Classify once per ring, on the debounced mean rather than a
+        // single noisy sample, as soon as enough samples have accumulated
+        if (!ring_classified && hue_samples.size() >= MIN_HUE_SAMPLES)
+        {
+            ring_classified = true;
+            int hue_mean = static_cast<int>(hue_samples.mean());
+            AllianceColor detectedColor = classifyHue(hue_mean, HUE_CALIBRATION_OFFSET);
+            Trace::event(TRACE_CLASSIFY, detectedColor);
+            Trace::event(TRACE_DETECT_LATENCY, colorDetector.lastDetectionLatencyUs());
+
+            // With a baked alliance the reject decision is a single probe of
+            // the compile-time table; the fallback classifies and compares
+            // against the runtime global
+            bool reject;
+            if constexpr (Alliance != UNKNOWN)
+            {
+                reject = rejectHue<Alliance>(hue_mean, HUE_CALIBRATION_OFFSET);
+            }
+            else
+            {
+                reject = detectedColor != UNKNOWN && detectedColor != target;
+            }
+
+            display.controllerPrintf(2, detectedColor == target ? "Color Match!"
+                                                                : "Color Mismatch!");
+
+            // Every classified ring enters the pipeline — accepted rings
+            // too, so the queue mirrors the physical order of rings in the
+            // intake and interleaved accept/reject decisions stay per-ring
+            if (detectedColor != UNKNOWN && pipeline_count < MAX_TRACKED_OBJECTS)
+            {
+                int tail = (pipeline_head + pipeline_count) % MAX_TRACKED_OBJECTS;
+                pipeline[tail].color = detectedColor;
+                pipeline[tail].detected_ms = now;
+                pipeline[tail].detected_position = snap.intake.position;
+                pipeline_count++;
+                if (reject)
+                {
+                    Trace::event(TRACE_EJECT_QUEUED, pipeline_count);
+                }
+            }
+        }
+    }
+    else
+    {
+        // Sensor window is clear; re-arm single-shot classification
+        if (ring_in_window)
         {
-            // Display a message indicating a color match
-            mainController.set_text(2, 0, "Color Match!");
-            // Intake motor continues to operate normally
+            ring_in_window = false;
         }
-        // Scenario 2: Detected color does not match the alliance color
-        else if (detectedColor != UNKNOWN)
+        else if (state == TRACKING && pipeline_count == 0)
         {
-            // Brief delay to allow the object to reach the eject position
-            pros::delay(TRAVEL_DELAY);
+            // Nothing detected and nothing in flight; the cell model makes
+            // rewriting the same text free. A dead sensor reads as permanent
+            // pass-through, so tell the driver sorting is offline.
+            display.controllerPrintf(2, snap.optical_ok ? "No Ring!"
+                                                        : "Sensor offline!");
+        }
+    }
 
-            // Stop the intake motor momentarily to eject the object
-            intake.move_velocity(0);
+    // --- Ejection pipeline: encoder driven, never blocks ----------------
+    switch (state)
+    {
+    case TRACKING:
+        // Retire every tracked ring that has reached the eject position.
+        // Travel is measured from each ring's own detection encoder
+        // position, so timing is correct at any intake RPM — and because the
+        // positions are encoder-based, stopping the intake simply pauses the
+        // whole pipeline in place.
+        while (pipeline_count > 0)
+        {
+            TrackedObject &head = pipeline[pipeline_head];
+            bool traveled = snap.intake.position - head.detected_position >= TRAVEL_DEGREES;
+            bool timed_out = now - head.detected_ms >= static_cast<uint32_t>(TRAVEL_TIMEOUT);
+            if (!traveled && !timed_out)
+            {
+                break; // Oldest ring still in flight; the rest are behind it
+            }
 
-            // Display a message indicating a color mismatch
-            mainController.set_text(2, 0, "Color Mismatch!");
+            active = head;
+            pipeline_head = (pipeline_head + 1) % MAX_TRACKED_OBJECTS;
+            pipeline_count--;
 
-            // Allow time for the object to be ejected via inertia
-            pros::delay(STOP_DELAY);
+            if (!traveled)
+            {
+                // The ring never traveled (jam or it fell out); drop it
+                // rather than stopping the intake for a ghost
+                continue;
+            }
+            if (active.color == target)
+            {
+                // Matching ring: it passes the eject position untouched, so
+                // the actuator stays free for the rejects around it
+                continue;
+            }
 
-            // Resume normal intake motor operation
-            intake.move_velocity(INTAKE_SPEED);
+            // Wrong-color ring at the eject position: stop the intake.
+            // Through the supervisor, so the stop is declared as intent —
+            // an EJECT_PAUSE, not a stall signature
+            intakeSupervisor.ejectPause();
+            Trace::event(TRACE_EJECT_STOP, now - active.detected_ms);
+
+            // Adaptive stop window: a fast-moving ring flies clear sooner, so
+            // scale the stop by the detection-time velocity around the tuned
+            // reference, clamped to sane bounds
+            double speed = std::abs(snap.intake.velocity);
+            int stop_ms = STOP_MAX_MS;
+            if (speed > 1.0)
+            {
+                stop_ms = static_cast<int>(STOP_REFERENCE_MS * REFERENCE_RPM / speed);
+            }
+            if (stop_ms < STOP_MIN_MS)
+            {
+                stop_ms = STOP_MIN_MS;
+            }
+            if (stop_ms > STOP_MAX_MS)
+            {
+                stop_ms = STOP_MAX_MS;
+            }
+            stop_deadline = now + stop_ms;
+            state = EJECTING;
+            break;
         }
-        // Scenario 3: No object is detected by the sensor
-        else
+        break;
+
+    case EJECTING:
+        if (now >= stop_deadline)
         {
-            // Display a message indicating that no object is detected
-            mainController.set_text(2, 0, "No Ring!");
-            // No changes to the intake motor state; remains under external control
+            // Ejection window elapsed; restore speed on the next pass
+            state = RESUMING;
         }
+        break;
 
-        // Add a small delay to prevent excessive sensor polling or spamming messages
-        pros::delay(50);
+    case RESUMING:
+        // Resume normal intake operation and hand the motor back to the
+        // driver; travel of the remaining pipeline picks up where the
+        // encoder left off
+        intakeSupervisor.run(INTAKE_SPEED);
+        Trace::event(TRACE_EJECT_RESUME);
+        state = TRACKING;
+        break;
     }
+
+    // The detector picks the cadence: 1 ms bursts while a ring is in the
+    // sensor window, a relaxed idle period otherwise. Detection latency is
+    // bounded by sensor integration time instead of this callback's period.
+    pollScheduler.setPeriod(colorSortHandle, colorDetector.recommendedDelayMs());
 }
 
 /**
- * @brief Starts the color sorting task if not already running.
+ * @brief Starts (or re-enables) the color sorting callback.
+ * @details First call registers the callback on the shared scheduler and
+ * starts it; later calls just flip the enable flag — no task churn.
  */
 void startColorSortTask()
 {
-    if (colorSortTaskHandle == nullptr)
+    if (colorSortHandle < 0)
     {
-        colorSortTaskHandle = new pros::Task(colorSortTask);
+        // One-read binary calibration load: venue hue offset, if captured
+        CalibrationData calibration;
+        if (CalibrationCache::load(calibration))
+        {
+            HUE_CALIBRATION_OFFSET = calibration.hue_offset_deg;
+        }
+
+        // The collector refreshes the shared snapshot; it stays enabled even
+        // while sorting is off so other consumers keep getting fresh data
+        telemetryHandle = pollScheduler.add("telemetry", telemetryStep, TelemetryCollector::COLLECT_PERIOD_MS);
+        pollScheduler.add("display", displayStep, DisplayService::FLUSH_PERIOD_MS);
+        pollScheduler.add("motor_owner", motorOwnerStep, MotorOwner::DRAIN_PERIOD_MS);
+        FlightRecorder::attach(); // Retain the whole match's trace events
+        // SD flushing blocks on card latency, so it runs on its own
+        // low-priority task rather than the cooperative scheduler
+        Trace::startFlushTask();
+        if (TELEMETRY_RECORD_ENABLED)
+        {
+            TelemetryRecorder::startFlushTask();
+        }
+        // Baked image, or alliance selected at startup between the two
+        // pre-instantiated steps; fully runtime only when neither is known
+        PollScheduler::Callback step;
+        if constexpr (COMPILED_ALLIANCE != UNKNOWN)
+        {
+            step = colorSortStepFor<COMPILED_ALLIANCE>;
+        }
+        else
+        {
+            step = ALLIANCE_COLOR == RED    ? colorSortStepFor<RED>
+                   : ALLIANCE_COLOR == BLUE ? colorSortStepFor<BLUE>
+                                            : colorSortStepFor<UNKNOWN>;
+        }
+        colorSortHandle = pollScheduler.add("color_sort", step, 2);
+
+        // Rings only move while the intake runs: the governor parks the
+        // sorter and idles telemetry whenever the intake intent is IDLE,
+        // and ramps both back within one governor step of a start edge
+        pollScheduler.add("duty_governor", dutyGovernorStep, DutyCycleGovernor::STEP_PERIOD_MS);
+        dutyGovernor.govern(telemetryHandle, TelemetryCollector::COLLECT_PERIOD_MS,
+                            DutyCycleGovernor::IDLE_PERIOD_MS);
+        dutyGovernor.govern(colorSortHandle, 2, 0);
+        pollScheduler.start();
+
+        // Supervise the scheduler: the color sort runs every 2 ms, so a
+        // heartbeat more than 10 ms stale means rings are slipping past
+        int schedulerWatch = watchdog.add("scheduler", pollScheduler.task(), 10);
+        pollScheduler.setHeartbeatSlot(watchdog.heartbeatSlot(schedulerWatch));
+        watchdog.attachScheduler(&pollScheduler);
+        telemetry.setHealthSource(&watchdog.health());
+        watchdog.start();
+    }
+    else
+    {
+        pollScheduler.setEnabled(colorSortHandle, true);
     }
 }
 
 /**
- * @brief Stops the color sorting task if it's running.
+ * @brief Stops the color sorting callback if it's running.
  */
 void stopColorSortTask()
 {
-    if (colorSortTaskHandle != nullptr)
-    {
-        colorSortTaskHandle->remove();
-        delete colorSortTaskHandle;
-        colorSortTaskHandle = nullptr;
-    }
+    pollScheduler.setEnabled(colorSortHandle, false);
+}
+
+/**
+ * @brief Competition disabled callback: the match is over, so dump the
+ * flight recorder's arena to the SD card in one sequential write.
+ */
+void disabled()
+{
+    FlightRecorder::dump();
 }
 
 /**
@@ -138,7 +538,8 @@ void opcontrol()
 {
     // Start the color sorting task
     startColorSortTask();
-    intake.move_velocity(600);
+    intakeOwner.sendVelocity(driverChannel, SOURCE_DRIVER, 600);
+    intakeSupervisor.declareRun(); // Wakes the governed sensor loops
 
     while (true)
     {
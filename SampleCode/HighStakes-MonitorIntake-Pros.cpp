@@ -1,6 +1,19 @@
 #include "pros/adi.hpp"
 #include "pros/motors.hpp"
 #include "pros/rtos.hpp"
+#include "PollScheduler.hpp"
+#include "TelemetrySnapshot.hpp"
+#include "StallDetector.hpp"
+#include "DisplayService.hpp"
+#include "MotorCommandQueue.hpp"
+#include "Trace.hpp"
+#include "CalibrationCache.hpp"
+#include "Watchdog.hpp"
+#include "FlightRecorder.hpp"
+#include "ControllerInput.hpp"
+#include "IntakeSupervisor.hpp"
+#include "Replay.hpp"
+#include "DutyCycleGovernor.hpp"
 
 /**
  * @file intake_control.cpp
@@ -8,10 +21,16 @@
  */
 
 /**
- * Global pointer to the intake monitoring task.
- * Initialized to nullptr, ensuring no task is running by default.
+ * @brief Cooperative scheduler shared by every periodic feature in this sample.
+ * @details One task, one stack: register additional sensor-polling callbacks
+ * (e.g. the color sorter) on this same scheduler instead of spawning tasks.
  */
-pros::Task *intake_monitor_task = nullptr;
+PollScheduler pollScheduler;
+
+/**
+ * @brief Scheduler handle for the intake monitor callback; -1 until registered.
+ */
+int intakeMonitorHandle = -1;
 
 /**
  * @brief Motor used for the intake mechanism.
@@ -19,6 +38,96 @@ pros::Task *intake_monitor_task = nullptr;
  */
 pros::Motor intake_motor(1);
 
+/**
+ * @brief Display service owning all screen writes for this sample.
+ * @details This sample logs to the brain LCD only, so no controller is wired.
+ */
+DisplayService display(nullptr);
+
+/**
+ * @brief The driver controller, polled by the input service below.
+ */
+pros::Controller main_controller(pros::E_CONTROLLER_MASTER);
+
+/**
+ * @brief Edge-detection input service: one controller pass per radio packet,
+ * debounced edges dispatched to the toggle handlers bound in opcontrol.
+ */
+ControllerInput input(&main_controller);
+
+/**
+ * @brief Scheduler callback that polls the controller and dispatches edges.
+ */
+void inputStep()
+{
+    input.pollStep();
+}
+
+/**
+ * @brief Scheduler callback that flushes dirty display lines.
+ */
+void displayStep()
+{
+    display.flushStep();
+}
+
+/**
+ * @brief Supervisor for the scheduler task: counts missed deadlines, bumps
+ * priority when it is starved, and publishes the CPU/slip accounting.
+ */
+Watchdog watchdog;
+
+/**
+ * @brief Single authority over the intake motor: all features enqueue
+ * commands; only the drain step below touches the device.
+ */
+MotorOwner intakeOwner(intake_motor);
+
+/**
+ * @brief Command channel for callbacks running on the scheduler task.
+ */
+int monitorChannel = intakeOwner.openChannel();
+
+/**
+ * @brief Command channel for driver commands. The input service dispatches
+ * its handlers on the scheduler task, so this channel's producer is that
+ * task — still exactly one producer, as the queue requires.
+ */
+int driverChannel = intakeOwner.openChannel();
+
+/**
+ * @brief Scheduler callback that drains queued motor commands.
+ */
+void motorOwnerStep()
+{
+    intakeOwner.drainStep();
+}
+
+/**
+ * @brief Shared telemetry collector: the only code that reads the intake
+ * motor's telemetry registers. This sample uses no optical sensor.
+ */
+TelemetryCollector telemetry(&intake_motor, nullptr);
+
+/**
+ * @brief Flip to true to record every snapshot to the SD card for replay
+ * tuning (see Replay.hpp); the branch folds away when disabled.
+ */
+constexpr bool TELEMETRY_RECORD_ENABLED = false;
+
+/**
+ * @brief Scheduler callback that refreshes the telemetry snapshot once per
+ * V5 device-update cycle.
+ */
+void telemetryStep()
+{
+    telemetry.collect();
+    if (TELEMETRY_RECORD_ENABLED)
+    {
+        TelemetryRecorder::feed(telemetry.read());
+    }
+}
+
 /**
  * @brief Enum to track the intake motor direction.
  */
@@ -30,27 +139,20 @@ enum IntakeDirection
 };
 IntakeDirection intake_direction = STOPPED; // Initialize to STOPPED
 
-/**
- * @brief Spin-up grace period in milliseconds.
- * @details Allows the motor time to reach operating speed before checking for stalls.
- */
-const int SPIN_UP_GRACE = 1000;
-
 /**
  * @brief Desired velocity for the intake motor in RPM.
  */
 const int DESIRED_VELOCITY = 600;
 
 /**
- * @brief Threshold velocity below which the motor is considered stuck.
- * @details If the motor's velocity falls below this value, corrective action will be taken.
+ * @brief Degrees to reverse the intake motor on the first recovery attempt.
  */
-const int VELOCITY_THRESHOLD = 50;
+const int REVERSE_DEGREES = 90;
 
 /**
- * @brief Degrees to reverse the intake motor when it is stuck.
+ * @brief Degrees to reverse on the escalated (second) recovery attempt.
  */
-const int REVERSE_DEGREES = 90;
+const int LONG_REVERSE_DEGREES = 270;
 
 /**
  * @brief Speed for reversing the intake motor.
@@ -58,134 +160,412 @@ const int REVERSE_DEGREES = 90;
 const int REVERSE_SPEED = -100;
 
 /**
- * @brief Starts the intake monitoring task.
+ * @brief Hard timeout (ms) for one recovery reversal to complete.
+ * @details If the reversal itself jams, this bounds how long we wait before
+ * escalating instead of spinning forever.
  */
-void startMonitoringTask()
+const int RECOVERY_TIMEOUT = 500;
+
+/**
+ * @brief Minimum time (ms) into a reversal before checking for completion,
+ * so the motor has a chance to start moving backward.
+ */
+const int RECOVERY_SPIN_UP = 100;
+
+/**
+ * @brief Period of the intake monitor callback in milliseconds.
+ */
+const int MONITOR_PERIOD = 20;
+
+/**
+ * @brief Predictive stall detector fed from the telemetry snapshot.
+ * @details Arms itself as soon as the motor reaches its commanded-velocity
+ * envelope, replacing the old fixed 1000 ms spin-up grace period.
+ */
+StallDetector stallDetector;
+
+/**
+ * @brief Intent authority over the intake: recovery reversals and resumes
+ * go through here, stall checks are gated on intent, and a return to RUN
+ * warm re-arms the detector so the resume spin-up is expected. If the
+ * color sorter joins this program, its ejection pauses use the same
+ * authority — which is what stops a commanded ejection stop from being
+ * misread as a stall.
+ */
+IntakeSupervisor intakeSupervisor(&intakeOwner, monitorChannel, &stallDetector);
+
+/**
+ * @brief Scales polling rates with intake activity: monitoring a motor
+ * whose target velocity is zero learns nothing, so the monitor and
+ * telemetry idle down whenever the intake intent is IDLE.
+ */
+DutyCycleGovernor dutyGovernor(&pollScheduler, &intakeSupervisor);
+
+/**
+ * @brief Scheduler callback for the duty-cycle governor.
+ */
+void dutyGovernorStep()
+{
+    dutyGovernor.step();
+}
+
+/**
+ * @brief Phases of the non-blocking stall recovery sequence.
+ * @details The recovery used to busy-wait until the reversal finished,
+ * leaving the monitor blind and spinning forever if the reversal itself
+ * jammed. Recovery is now timestamp driven with a hard timeout and
+ * escalating strategies: short reverse, then a longer reverse, then a full
+ * stop with an alert.
+ */
+enum RecoveryState
 {
-    if (intake_monitor_task == nullptr)
+    MONITORING, // No recovery in flight; watching for stall signatures
+    RECOVERING, // A reversal has been commanded; watching it complete
+    FAULTED     // Escalation exhausted; intake stopped until re-armed
+};
+RecoveryState recovery_state = MONITORING; // Current recovery phase
+int recovery_attempt = 0;                  // Recovery attempts for the current jam
+uint32_t recovery_started = 0;             // Timestamp (ms) the current reversal began
+
+/**
+ * @brief Plain stats frame the monitor publishes instead of drawing.
+ * @details The stall branches used to issue display prints directly — each
+ * one a separate screen transaction, and when a stall flapped the prints
+ * dominated the monitor loop. The hot loop now just writes these fields; the
+ * renderer below owns every display call.
+ */
+struct StallStats
+{
+    uint32_t stall_count = 0;   // Stalls detected since boot
+    double last_velocity = 0.0; // Intake velocity at the last stall (RPM)
+    int attempt = 0;            // Recovery attempts for the current jam
+    RecoveryState state = MONITORING; // Recovery phase to render
+};
+StallStats stallStats;
+
+/**
+ * @brief Scheduler callback that renders the stats frame, capped at 10 Hz.
+ * @details Composes every line of the frame in one pass; the display
+ * service's dirty-cell model means unchanged lines cost nothing and changed
+ * lines go out in its next batched flush. Render rate is independent of the
+ * monitor's detection frequency.
+ */
+void statsRenderStep()
+{
+    switch (stallStats.state)
     {
-        intake_monitor_task = new pros::Task(intake_monitor_task_function, nullptr, "Intake Monitor Task");
+    case MONITORING:
+        display.brainPrintf(0, "Intake OK (stalls: %lu)",
+                            static_cast<unsigned long>(stallStats.stall_count));
+        break;
+    case RECOVERING:
+        display.brainPrintf(0, "Intake stuck! Reversing... (try %d)", stallStats.attempt);
+        break;
+    case FAULTED:
+        display.brainPrintf(0, "Intake jammed! Gave up after %d tries", stallStats.attempt);
+        break;
     }
+    display.brainPrintf(2, "Stall velocity: %.2f", stallStats.last_velocity);
 }
 
 /**
- * @brief Stops the intake monitoring task.
+ * @brief Period (ms) of the stats renderer: 10 Hz, plenty for human eyes.
  */
-void stopMonitoringTask()
+const int STATS_RENDER_PERIOD = 100;
+
+/**
+ * @brief Commands one recovery reversal, escalating with the attempt number.
+ * @details Attempt 1 is a short reverse; attempt 2 a longer one. Attempt 3
+ * gives up: the intake is stopped and an alert is shown until the driver
+ * re-arms monitoring.
+ */
+void startRecoveryAttempt(uint32_t now)
 {
-    if (intake_monitor_task != nullptr)
+    recovery_attempt++;
+    if (recovery_attempt > 2)
     {
-        intake_monitor_task->remove(); // Stop the task
-        delete intake_monitor_task;    // Free the allocated memory
-        intake_monitor_task = nullptr;
+        // Escalation exhausted: full stop and alert. Recovery keeps motor
+        // authority so nothing restarts the jammed intake until re-armed.
+        intakeSupervisor.faultStop();
+        stallStats.attempt = recovery_attempt - 1;
+        Trace::event(TRACE_RECOVERY_FAULT, recovery_attempt - 1);
+        recovery_state = FAULTED;
+        stallStats.state = FAULTED;
+        return;
     }
+
+    int degrees = (recovery_attempt == 1) ? REVERSE_DEGREES : LONG_REVERSE_DEGREES;
+    stallStats.attempt = recovery_attempt;
+    intakeSupervisor.recover(-degrees, REVERSE_SPEED);
+    Trace::event(TRACE_RECOVERY_START, recovery_attempt);
+    recovery_started = now;
+    recovery_state = RECOVERING;
+    stallStats.state = RECOVERING;
 }
 
 /**
- * @brief Task function that monitors the intake motor for stalls and takes corrective action.
- *
- * This task continuously checks the velocity of the intake motor. If the velocity falls below
- * the defined threshold while the motor is supposed to be running, it assumes the motor is stuck.
- * To resolve this, the motor is reversed for a certain number of degrees before resuming
- * normal operation.
+ * @brief One stall-monitoring iteration, run periodically by the scheduler.
  *
- * @param param Pointer to additional data passed to the task (not used here, can be nullptr).
+ * Feeds the predictive stall detector from the telemetry snapshot. The
+ * detector flags an incipient stall (rising current with falling velocity)
+ * within ~50 ms of onset instead of waiting for raw velocity to collapse
+ * below a threshold. Recovery runs as a non-blocking state machine: the
+ * monitor keeps watching velocity while a reversal is in flight, a hard
+ * timeout catches a reversal that jams, and strategies escalate from a
+ * short reverse to a longer reverse to a full stop with an alert.
  */
-void intake_monitor_task_function(void *param)
+void intakeMonitorStep()
 {
-    bool reversing = false;        // Track if the motor is currently reversing
-    bool use_spin_up_grace = true; // Grace period flag to allow for "spooling", when the motor starts spinning the first time
+    uint32_t now = pros::millis();
 
-    while (true)
+    // One coherent device sample for this iteration; zero device calls here
+    TelemetrySnapshot snap = telemetry.read();
+
+    // A dead motor port means no fresh telemetry: do not judge stalls (or
+    // time out recoveries) on frozen data. The collector probes for the
+    // device and full monitoring resumes when it answers again.
+    if (!snap.intake_ok)
     {
-        // Get the current velocity of the intake motor
-        double current_velocity = intake_motor.get_actual_velocity();
+        return;
+    }
 
-        // Allow a grace period for spin-up after the motor starts
-        if (use_spin_up_grace)
+    // Update the rolling current/velocity window every iteration, even while
+    // a recovery is in flight
+    stallDetector.update(snap);
+
+    switch (recovery_state)
+    {
+    case MONITORING:
+        // Intent-aware check: only reports while the intake is supposed to
+        // be running, so commanded stops and reversals cannot false-trigger
+        if (intakeSupervisor.stallDetected())
         {
-            pros::delay(SPIN_UP_GRACE); // Use configurable grace period for spin-up
-            use_spin_up_grace = false;  // Disable grace period after initial delay
-            continue;                   // Skip the stuck check during grace period
+            stallStats.stall_count++;
+            stallStats.last_velocity = snap.intake.velocity;
+            Trace::event(TRACE_STALL_DETECTED, static_cast<int32_t>(snap.intake.velocity));
+            recovery_attempt = 0;
+            startRecoveryAttempt(now);
         }
+        break;
 
-        // Check if the intake motor is stuck
-        if (!reversing && abs(current_velocity) < VELOCITY_THRESHOLD && intake_motor.get_target_velocity() != 0)
+    case RECOVERING:
+        if (now - recovery_started >= static_cast<uint32_t>(RECOVERY_TIMEOUT))
         {
-            // Log a message to the LCD for debugging purposes
-            pros::lcd::print(0, "Intake stuck! Reversing...");
-            pros::lcd::print(2, "Current velocity: %.2f", current_velocity);
-
-            // Reverse the intake motor to resolve the stall
-            reversing = true; // Set reversing flag to avoid repeated reversals
-            intake_motor.move_relative(-REVERSE_DEGREES, REVERSE_SPEED);
-
-            // Wait for the reverse motion to complete
-            while (abs(intake_motor.get_actual_velocity()) > 1)
-            {
-                pros::delay(10);
-            }
-
-            // Resume normal intake operation
-            intake_motor.move_velocity(DESIRED_VELOCITY);
-            reversing = false; // Reset the reversing flag
+            // The reversal itself jammed or never completed: escalate
+            startRecoveryAttempt(now);
         }
+        else if (now - recovery_started >= static_cast<uint32_t>(RECOVERY_SPIN_UP) &&
+                 abs(snap.intake.velocity) < 1)
+        {
+            // Reversal finished: resume normal intake operation and hand
+            // the motor back to the driver. The supervisor warm re-arms the
+            // detector on the transition, so the post-recovery spin-up is
+            // tracked as a fresh envelope entry without forgetting the
+            // learned envelope.
+            intakeSupervisor.run(DESIRED_VELOCITY);
+            Trace::event(TRACE_RECOVERY_DONE);
+            recovery_state = MONITORING;
+            stallStats.state = MONITORING;
+        }
+        break;
 
-        // Delay to reduce CPU usage of the task
-        pros::delay(20);
+    case FAULTED:
+        // Stay stopped until the driver toggles the intake, which re-arms
+        // monitoring through startMonitoringTask
+        break;
     }
 }
 
 /**
- * @brief Main operator control function for the robot.
- *
- * This function starts the intake monitoring task and handles manual control of the intake motor
- * based on controller input. The intake motor runs at the desired velocity when the R1 button is
- * pressed, and stops when the button is released.
+ * @brief Registers the always-on infrastructure callbacks (telemetry,
+ * display, motor owner) and starts the scheduler. Safe to call repeatedly.
  */
-void opcontrol()
+void ensureSchedulerStarted()
 {
-    while (true)
+    static bool started = false;
+    if (!started)
     {
-        // Toggle forward intake with R1
-        if (pros::controller_get_digital_new_press(pros::E_CONTROLLER_DIGITAL_R1))
+        started = true;
+        // The collector refreshes the shared snapshot; it stays enabled even
+        // while monitoring is off so other consumers keep getting fresh data
+        int telemetryHandle = pollScheduler.add("telemetry", telemetryStep, TelemetryCollector::COLLECT_PERIOD_MS);
+        pollScheduler.add("display", displayStep, DisplayService::FLUSH_PERIOD_MS);
+        pollScheduler.add("stats_render", statsRenderStep, STATS_RENDER_PERIOD);
+        pollScheduler.add("motor_owner", motorOwnerStep, MotorOwner::DRAIN_PERIOD_MS);
+        FlightRecorder::attach(); // Retain the whole match's trace events
+        // SD flushing blocks on card latency, so it runs on its own
+        // low-priority task rather than the cooperative scheduler
+        Trace::startFlushTask();
+        if (TELEMETRY_RECORD_ENABLED)
         {
-            if (intake_direction == FORWARD)
-            {
-                // If currently forward, stop the intake
-                intake_motor.move_velocity(0);
-                intake_direction = STOPPED;
-                stopMonitoringTask(); // Stop monitoring
-            }
-            else
-            {
-                // Start forward intake
-                intake_motor.move_velocity(DESIRED_VELOCITY); // Forward intake speed
-                intake_direction = FORWARD;
-                startMonitoringTask(); // Start monitoring
-            }
+            TelemetryRecorder::startFlushTask();
         }
+        // Idle the collector down to the deep-idle rate while the intake
+        // is stopped; the governor ramps it back on the start edge. The
+        // input poll is deliberately ungoverned — a button press is how
+        // the robot stops being idle
+        pollScheduler.add("duty_governor", dutyGovernorStep, DutyCycleGovernor::STEP_PERIOD_MS);
+        dutyGovernor.govern(telemetryHandle, TelemetryCollector::COLLECT_PERIOD_MS,
+                            DutyCycleGovernor::IDLE_PERIOD_MS);
+        pollScheduler.start();
 
-        // Toggle reverse intake with A
-        if (pros::controller_get_digital_new_press(pros::E_CONTROLLER_DIGITAL_A))
+        // Supervise the scheduler: the stall monitor runs every 20 ms, so a
+        // heartbeat more than 20 ms stale means protection has lapsed
+        int schedulerWatch = watchdog.add("scheduler", pollScheduler.task(), 20);
+        pollScheduler.setHeartbeatSlot(watchdog.heartbeatSlot(schedulerWatch));
+        watchdog.attachScheduler(&pollScheduler);
+        telemetry.setHealthSource(&watchdog.health());
+        watchdog.start();
+    }
+}
+
+/**
+ * @brief Starts (or resumes) the intake monitor callback.
+ * @details The monitor is persistent: the first call registers it on the
+ * shared scheduler, and every later call is an O(1) enable-flag flip that
+ * takes effect within one scheduler tick — no task churn, no re-registration.
+ * The stall detector does a cold reset only on the genuine first start;
+ * driver toggles warm re-arm it, retaining the learned spin-up envelope so
+ * protection is back as soon as the motor reaches speed instead of after a
+ * fixed worst-case grace.
+ */
+void startMonitoringTask()
+{
+    static bool cold_start = true;
+    if (cold_start)
+    {
+        cold_start = false;
+        stallDetector.reset(); // Genuine cold start: learn the envelope fresh
+
+        // One-read binary calibration load: a previously measured spin-up
+        // time arms stall protection fast even on the first run of the day
+        CalibrationData calibration;
+        if (CalibrationCache::load(calibration))
         {
-            if (intake_direction == BACKWARD)
-            {
-                // If currently backward, stop the intake
-                intake_motor.move_velocity(0);
-                intake_direction = STOPPED;
-                stopMonitoringTask(); // Stop monitoring
-            }
-            else
-            {
-                // Start reverse intake
-                intake_motor.move_velocity(-DESIRED_VELOCITY); // Reverse intake speed
-                intake_direction = BACKWARD;
-                stopMonitoringTask(); // Stop monitoring (monitoring only for forward intake)
-            }
+            stallDetector.seedSpinUp(calibration.spin_up_ms);
         }
+    }
+    else
+    {
+        stallDetector.rearm(); // Driver toggle: keep the learned envelope
+    }
+    recovery_state = MONITORING; // Clear any leftover recovery/fault state
+    recovery_attempt = 0;
+    stallStats.state = MONITORING;
+    // A re-arm also clears any authority a FAULTED recovery was holding
+    intakeOwner.sendRelease(driverChannel, SOURCE_RECOVERY);
+    ensureSchedulerStarted();
+    if (intakeMonitorHandle < 0)
+    {
+        intakeMonitorHandle = pollScheduler.add("intake_monitor", intakeMonitorStep, MONITOR_PERIOD);
+        // Parked entirely while the intake is idle: there is nothing to
+        // protect at zero target velocity
+        dutyGovernor.govern(intakeMonitorHandle, MONITOR_PERIOD, 0);
+    }
+    else
+    {
+        pollScheduler.setEnabled(intakeMonitorHandle, true);
+    }
+}
 
-        // Delay to prevent excessive CPU usage
+/**
+ * @brief Suspends the intake monitor callback.
+ * @details Disable only — all detector and recovery state is retained for
+ * the next resume.
+ */
+void stopMonitoringTask()
+{
+    pollScheduler.setEnabled(intakeMonitorHandle, false);
+}
+
+/**
+ * @brief Competition disabled callback: the match is over, so dump the
+ * flight recorder's arena to the SD card in one sequential write.
+ */
+void disabled()
+{
+    FlightRecorder::dump();
+}
+
+/**
+ * @brief R1 press: toggles forward intake (with stall monitoring).
+ * @details Runs on the scheduler task via the input service.
+ */
+void toggleForwardIntake()
+{
+    if (intake_direction == FORWARD)
+    {
+        // If currently forward, stop the intake
+        intakeOwner.sendVelocity(driverChannel, SOURCE_DRIVER, 0);
+        intake_direction = STOPPED;
+        stopMonitoringTask();           // Stop monitoring
+        intakeSupervisor.declareIdle(); // Zero velocity is now expected
+    }
+    else
+    {
+        // Re-arm monitoring first: leaving FAULTED enqueues the recovery-
+        // authority release on this same channel, and the release must
+        // drain before the velocity command below or the arbitration
+        // drops the command while RECOVERY still holds the motor
+        startMonitoringTask();
+        intakeOwner.sendVelocity(driverChannel, SOURCE_DRIVER, DESIRED_VELOCITY); // Forward intake speed
+        intake_direction = FORWARD;
+        intakeSupervisor.declareRun(); // Stall expectations now apply
+    }
+}
+
+/**
+ * @brief A press: toggles reverse intake (no monitoring; it only protects
+ * forward intake).
+ * @details Runs on the scheduler task via the input service.
+ */
+void toggleReverseIntake()
+{
+    if (intake_direction == BACKWARD)
+    {
+        // If currently backward, stop the intake
+        intakeOwner.sendVelocity(driverChannel, SOURCE_DRIVER, 0);
+        intake_direction = STOPPED;
+        stopMonitoringTask();           // Stop monitoring
+        intakeSupervisor.declareIdle(); // Zero velocity is now expected
+    }
+    else
+    {
+        // Start reverse intake
+        intakeOwner.sendVelocity(driverChannel, SOURCE_DRIVER, -DESIRED_VELOCITY); // Reverse intake speed
+        intake_direction = BACKWARD;
+        stopMonitoringTask();           // Stop monitoring (monitoring only for forward intake)
+        intakeSupervisor.declareIdle(); // Reverse motion is driver intent, not a stall
+    }
+}
+
+/**
+ * @brief Main operator control function for the robot.
+ *
+ * Driver input is event-driven: the bindings below hand R1 and A to the
+ * edge-detection input service, which polls the whole controller once per
+ * radio packet and dispatches on debounced edges. Adding a button is one
+ * bind call, not another branch in a poll loop, and input latency is
+ * bounded by the radio packet period instead of a 20 ms loop.
+ */
+void opcontrol()
+{
+    // Bring up telemetry, display, and the motor owner before any commands
+    ensureSchedulerStarted();
+
+    // Bind the driver controls once, then start the input poll
+    static bool input_bound = false;
+    if (!input_bound)
+    {
+        input_bound = true;
+        input.bind(pros::E_CONTROLLER_DIGITAL_R1, ControllerInput::EDGE_PRESS, toggleForwardIntake);
+        input.bind(pros::E_CONTROLLER_DIGITAL_A, ControllerInput::EDGE_PRESS, toggleReverseIntake);
+        pollScheduler.add("input", inputStep, ControllerInput::POLL_PERIOD_MS);
+    }
+
+    while (true)
+    {
+        // All driver input dispatches from the input service; nothing to poll
         pros::delay(20);
     }
 }
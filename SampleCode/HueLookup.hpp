@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @file HueLookup.hpp
+ * @brief Compile-time hue classification table for the color sorter.
+ *
+ * detectColor() used to classify hue with chained range comparisons, which
+ * grows a new branch pair for every color band we teach it. Here the hue bands
+ * are declared as data and expanded at compile time into a 360-entry lookup
+ * table, so classification on the hot path is a single bounds-checked array
+ * index regardless of how many bands are configured. Per-venue hue calibration
+ * is applied as an offset at lookup time, so retuning for arena lighting never
+ * touches the classification code.
+ */
+
+/**
+ * @brief Enumeration of alliance colors.
+ * Used to determine the robot's team color and apply related logic.
+ */
+enum AllianceColor
+{
+    RED,
+    BLUE,
+    UNKNOWN
+};
+
+/**
+ * @brief One classified hue band: [begin, end] degrees map to a color.
+ * @details Bands may wrap past 360 (e.g. red as 330..390 covers 330-359 and
+ * 0-30); the table builder folds wrapped degrees back into range.
+ */
+struct HueBand
+{
+    int begin;           // First hue degree of the band (inclusive)
+    int end;             // Last hue degree of the band (inclusive); may exceed 359 to wrap
+    AllianceColor color; // Classification for hues inside the band
+};
+
+/**
+ * @brief Builds the 360-entry classification table from a set of hue bands.
+ *
+ * Runs entirely at compile time: the result is a constexpr std::array living
+ * in read-only data, with every degree not covered by a band set to UNKNOWN.
+ *
+ * @tparam N Number of bands.
+ * @param bands The configured hue bands.
+ * @return 360-entry table mapping hue degree to AllianceColor.
+ */
+template <std::size_t N>
+constexpr std::array<AllianceColor, 360> makeHueTable(const std::array<HueBand, N> &bands)
+{
+    std::array<AllianceColor, 360> table{};
+    for (int hue = 0; hue < 360; hue++)
+    {
+        table[hue] = UNKNOWN; // Degrees outside every band classify as UNKNOWN
+    }
+    for (std::size_t i = 0; i < N; i++)
+    {
+        for (int hue = bands[i].begin; hue <= bands[i].end; hue++)
+        {
+            table[hue % 360] = bands[i].color; // Fold wrapped degrees into range
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Hue bands for the High Stakes ring colors.
+ * @details Edit these (or add bands for other game objects) and the lookup
+ * table regenerates at compile time — the hot path never changes.
+ */
+constexpr std::array<HueBand, 2> HUE_BANDS = {{
+    {330, 390, RED}, // Red wraps through 0: covers 330-359 and 0-30
+    {210, 270, BLUE},
+}};
+
+/**
+ * @brief The compile-time generated hue classification table.
+ */
+constexpr std::array<AllianceColor, 360> HUE_TABLE = makeHueTable(HUE_BANDS);
+
+/**
+ * @brief Classifies a hue reading via the lookup table.
+ *
+ * @param hue Hue in degrees as reported by the optical sensor.
+ * @param calibration_offset Per-venue hue shift in degrees (default none);
+ * applied before lookup so lighting drift is corrected in one place.
+ * @return The classified color, or UNKNOWN for out-of-band hues.
+ */
+constexpr AllianceColor classifyHue(int hue, int calibration_offset = 0)
+{
+    int index = (hue + calibration_offset) % 360;
+    if (index < 0)
+    {
+        index += 360; // Keep negative offsets in range
+    }
+    return HUE_TABLE[index];
+}
+
+/**
+ * @brief Builds the accept/reject table baked for one alliance: true where
+ * the hue classifies as a color we eject (any band that is neither ours nor
+ * UNKNOWN).
+ */
+template <AllianceColor Alliance>
+constexpr std::array<bool, 360> makeRejectTable()
+{
+    std::array<bool, 360> table{};
+    for (int hue = 0; hue < 360; hue++)
+    {
+        table[hue] = HUE_TABLE[hue] != Alliance && HUE_TABLE[hue] != UNKNOWN;
+    }
+    return table;
+}
+
+/**
+ * @brief The per-alliance reject table; one instantiation per alliance the
+ * program is built for.
+ */
+template <AllianceColor Alliance>
+inline constexpr std::array<bool, 360> REJECT_TABLE = makeRejectTable<Alliance>();
+
+/**
+ * @brief Reject decision with the alliance baked in at compile time: one
+ * probe of REJECT_TABLE, no classify-then-compare on the hot path.
+ *
+ * @tparam Alliance The alliance whose rings are kept.
+ * @param hue Hue in degrees as reported by the optical sensor.
+ * @param calibration_offset Per-venue hue shift in degrees (default none).
+ * @return true if a ring with this hue should be ejected.
+ */
+template <AllianceColor Alliance>
+constexpr bool rejectHue(int hue, int calibration_offset = 0)
+{
+    int index = (hue + calibration_offset) % 360;
+    if (index < 0)
+    {
+        index += 360; // Keep negative offsets in range
+    }
+    return REJECT_TABLE<Alliance>[index];
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file HueSampleBuffer.hpp
+ * @brief Fixed-capacity ring buffer with O(1) rolling statistics for hue samples.
+ *
+ * Single-sample hue reads are noisy under arena lighting, which forces wide
+ * classification bands and raises misclassification. This buffer lets the
+ * sorter classify on a debounced rolling mean instead: every sample updates
+ * the running sum and sum-of-squares incrementally (add the new sample,
+ * subtract the evicted one), so mean and variance are O(1) per push with no
+ * loop over history, no heap allocation, and a footprint of a few hundred
+ * bytes — comfortable in the V5's RAM.
+ *
+ * Hue is circular, and the default alliance's RED band deliberately
+ * straddles the 0/360 wrap (see HueLookup.hpp), so a plain arithmetic mean
+ * is wrong for exactly the samples that matter most: {356, 2, 359, 5}
+ * averages to 180 — the opposite side of the color wheel. Each sample is
+ * therefore unwrapped to within ±180° of the first sample after a clear
+ * before accumulating, and mean() folds the result back into [0, 360).
+ *
+ * The sums are accumulated relative to that same first sample (variance is
+ * shift-invariant, and the mean just adds the origin back). This keeps
+ * their magnitudes at the spread of the data rather than its absolute
+ * value, which is what lets the Q16.16 instantiation stay inside its
+ * ±32 K range: unwrapped hue samples within one ring's pass-by cluster
+ * within a few degrees of each other even though the raw values run to 360.
+ *
+ * Concurrency: written from exactly one task. Another task may read mean()/
+ * variance() concurrently; a read that races a push can see a value one
+ * sample stale, which is harmless for smoothing.
+ */
+
+/**
+ * @brief Power-of-two-sized ring buffer maintaining rolling mean and variance.
+ * @tparam Capacity Number of samples retained; must be a power of two so
+ * indexing is a single mask instead of a modulo.
+ * @tparam Math Arithmetic type the statistics are computed in: double (the
+ * default, right for the V5's hard FPU) or Fixed from FixedPoint.hpp for
+ * FPU-less coprocessor ports.
+ */
+template <std::size_t Capacity, typename Math = double>
+class HueSampleBuffer
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two for mask indexing");
+
+public:
+    /**
+     * @brief Inserts a sample, evicting the oldest when full. O(1).
+     * @param sample Hue reading in degrees.
+     */
+    void push(Math sample)
+    {
+        if (count_ == 0 && head_ == 0)
+        {
+            origin_ = sample; // First sample after a clear anchors the sums
+        }
+        std::size_t index = head_ & MASK;
+        if (count_ == Capacity)
+        {
+            // Buffer full: remove the evicted sample's contribution first
+            Math evicted = samples_[index];
+            sum_ -= evicted;
+            sum_sq_ -= evicted * evicted;
+        }
+        else
+        {
+            count_++;
+        }
+        // Unwrap across the 0/360 hue wrap: a sample on the far side of the
+        // wrap from the origin accumulates as its nearby equivalent (e.g.
+        // origin 356, sample 2 -> centered +6, not -354)
+        Math centered = sample - origin_;
+        while (centered > Math(180))
+        {
+            centered -= Math(360);
+        }
+        while (centered < Math(-180))
+        {
+            centered += Math(360);
+        }
+        samples_[index] = centered;
+        sum_ += centered;
+        sum_sq_ += centered * centered;
+        head_++;
+    }
+
+    /**
+     * @brief Rolling mean of the buffered samples. O(1).
+     * @return Circular mean hue, folded into [0, 360); 0 when empty.
+     */
+    Math mean() const
+    {
+        if (count_ == 0)
+        {
+            return Math();
+        }
+        Math m = origin_ + sum_ / Math(static_cast<int>(count_));
+        while (m < Math(0))
+        {
+            m += Math(360);
+        }
+        while (m >= Math(360))
+        {
+            m -= Math(360);
+        }
+        return m;
+    }
+
+    /**
+     * @brief Rolling population variance of the buffered samples. O(1).
+     * @details Useful as a confidence gate: high variance means the ring is
+     * still entering the window or lighting is flickering.
+     */
+    Math variance() const
+    {
+        if (count_ == 0)
+        {
+            return Math();
+        }
+        Math m = sum_ / Math(static_cast<int>(count_));
+        return sum_sq_ / Math(static_cast<int>(count_)) - m * m;
+    }
+
+    /**
+     * @brief Number of samples currently held (saturates at Capacity).
+     */
+    std::size_t size() const
+    {
+        return count_;
+    }
+
+    /**
+     * @brief Discards all samples, e.g. when a new ring enters the window.
+     */
+    void clear()
+    {
+        head_ = 0;
+        count_ = 0;
+        sum_ = Math();
+        sum_sq_ = Math();
+    }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    Math samples_[Capacity] = {};   // Unwrapped, origin-centered samples
+    std::size_t head_ = 0;          // Next write position (monotonic, masked on use)
+    std::size_t count_ = 0;         // Valid samples held
+    Math origin_ = Math();          // Accumulation origin: first sample after a clear
+    Math sum_ = Math();             // Rolling sum (relative to origin_) for O(1) mean
+    Math sum_sq_ = Math();          // Rolling sum of squares (relative to origin_)
+};
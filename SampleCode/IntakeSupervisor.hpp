@@ -0,0 +1,198 @@
+#pragma once
+
+#include "MotorCommandQueue.hpp"
+#include "StallDetector.hpp"
+
+/**
+ * @file IntakeSupervisor.hpp
+ * @brief Single intent-tracking authority over the intake motor.
+ *
+ * The color sorter's ejection stop is indistinguishable from a stall to a
+ * detector that only sees velocity and current: the intake is commanded to
+ * zero, velocity collapses, and a monitor that does not know why will fire a
+ * 90-degree recovery reversal mid-ejection — reproduced on the practice
+ * field at ~500 ms of intake downtime per false trigger. The missing piece
+ * is intent: the motor's speed is only a fault if nobody asked for it.
+ *
+ * The supervisor owns the scheduler-side motor channel and is the one place
+ * features state what the intake is supposed to be doing: RUN (normal
+ * intake), EJECT_PAUSE (sorter-commanded stop; zero velocity is expected),
+ * RECOVER (reversal in flight; reverse motion is expected), or IDLE.
+ * Commands still arbitrate through the motor-owner queue with the same
+ * priority sources as before — the supervisor adds the intent bookkeeping on
+ * top, not a second command path.
+ *
+ * The detectors run against intent-aware expectations: stallDetected() only
+ * reports during RUN, and returning to RUN from a pause or recovery warm
+ * re-arms the detector so the resume spin-up is tracked as a fresh envelope
+ * entry instead of being misread as a collapsed velocity under load.
+ */
+
+/**
+ * @brief What the intake motor is currently supposed to be doing.
+ */
+enum IntakeIntent
+{
+    INTENT_IDLE,        // No commanded motion (stopped or faulted)
+    INTENT_RUN,         // Normal intake; stall expectations active
+    INTENT_EJECT_PAUSE, // Sorter-commanded stop; zero velocity is expected
+    INTENT_RECOVER      // Recovery reversal; reverse motion is expected
+};
+
+/**
+ * @brief The intent authority; construct one per program, next to the
+ * MotorOwner whose scheduler-side channel it drives.
+ */
+class IntakeSupervisor
+{
+public:
+    /**
+     * @brief @param owner The motor-owner queue all commands go through.
+     * @param channel The scheduler-task channel the supervisor commands on.
+     * @param detector The stall detector to coordinate, or nullptr in
+     * programs without stall monitoring.
+     */
+    IntakeSupervisor(MotorOwner *owner, int channel, StallDetector *detector = nullptr)
+        : owner_(owner), channel_(channel), detector_(detector)
+    {
+    }
+
+    /**
+     * @brief The current intent, for any feature that needs to know what
+     * the motor is supposed to be doing (detectors, duty-cycle governors).
+     */
+    IntakeIntent intent() const
+    {
+        return intent_;
+    }
+
+    /**
+     * @brief Returns to normal intake at the given speed.
+     * @details Releases whatever authority (ejection or recovery) held the
+     * motor, and warm re-arms the stall detector so the resume spin-up is
+     * expected rather than flagged.
+     */
+    void run(int velocity_rpm)
+    {
+        MotorCommandSource source = activeSource();
+        owner_->sendVelocity(channel_, source, velocity_rpm);
+        if (source != SOURCE_DRIVER)
+        {
+            owner_->sendRelease(channel_, source);
+        }
+        setIntent(INTENT_RUN);
+    }
+
+    /**
+     * @brief Sorter-commanded stop so a reject ring flies clear. Zero
+     * velocity is now expected, so no detector will read it as a stall.
+     */
+    void ejectPause()
+    {
+        owner_->sendVelocity(channel_, SOURCE_EJECT, 0);
+        setIntent(INTENT_EJECT_PAUSE);
+    }
+
+    /**
+     * @brief Commands a recovery reversal; reverse motion is now expected.
+     */
+    void recover(double degrees, int speed_rpm)
+    {
+        owner_->sendRelative(channel_, SOURCE_RECOVERY, degrees, speed_rpm);
+        setIntent(INTENT_RECOVER);
+    }
+
+    /**
+     * @brief Stops the intake after exhausted recovery escalation.
+     * @details Recovery authority is deliberately not released: nothing may
+     * restart the jammed intake until the driver re-arms.
+     */
+    void faultStop()
+    {
+        owner_->sendVelocity(channel_, SOURCE_RECOVERY, 0);
+        setIntent(INTENT_IDLE);
+    }
+
+    /**
+     * @brief Declares that the intake is running without sending a command,
+     * for speeds commanded on the driver's own channel. Arms the intent
+     * gate (and the detector re-arm) just like run().
+     * @details Ignored while an ejection pause or recovery holds the motor:
+     * a declaration moves no queue authority, so accepting it there would
+     * desynchronize intent from the authority activeSource() must later
+     * release — run() would then command on SOURCE_DRIVER, be dropped by
+     * the arbitration, and leave the higher source holding the motor
+     * forever. The owning feature's run()/faultStop() is the only exit
+     * from those states.
+     */
+    void declareRun()
+    {
+        if (intent_ == INTENT_IDLE || intent_ == INTENT_RUN)
+        {
+            setIntent(INTENT_RUN);
+        }
+    }
+
+    /**
+     * @brief Declares that the intake is intentionally not running (driver
+     * stop or reverse), disarming the stall expectations.
+     * @details Ignored mid-pause or mid-recovery for the same reason as
+     * declareRun(): intent must keep naming the authority in flight.
+     */
+    void declareIdle()
+    {
+        if (intent_ == INTENT_IDLE || intent_ == INTENT_RUN)
+        {
+            setIntent(INTENT_IDLE);
+        }
+    }
+
+    /**
+     * @brief Intent-aware stall check: the detector's verdict, but only
+     * while the intake is supposed to be running.
+     */
+    bool stallDetected() const
+    {
+        return intent_ == INTENT_RUN && detector_ != nullptr && detector_->stallDetected();
+    }
+
+private:
+    /**
+     * @brief The command source matching the current intent, so run() both
+     * commands the speed and releases the right authority.
+     */
+    MotorCommandSource activeSource() const
+    {
+        switch (intent_)
+        {
+        case INTENT_EJECT_PAUSE:
+            return SOURCE_EJECT;
+        case INTENT_RECOVER:
+            return SOURCE_RECOVERY;
+        default:
+            return SOURCE_DRIVER;
+        }
+    }
+
+    /**
+     * @brief Records an intent transition, re-arming the detector when the
+     * intake returns to normal running.
+     */
+    void setIntent(IntakeIntent next)
+    {
+        if (next == intent_)
+        {
+            return;
+        }
+        if (next == INTENT_RUN && detector_ != nullptr)
+        {
+            detector_->rearm(); // Expect a fresh spin-up, keep the learned envelope
+        }
+        intent_ = next;
+    }
+
+    MotorOwner *owner_;                // The arbitration queue; not owned
+    int channel_;                      // Scheduler-task command channel
+    StallDetector *detector_;          // Coordinated detector, or nullptr
+    IntakeIntent intent_ = INTENT_IDLE; // What the motor should be doing
+};
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "pros/motors.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file MotorCommandQueue.hpp
+ * @brief Lock-free command queues feeding a single motor-owner drain step.
+ *
+ * With the color sorter, the stall monitor, and opcontrol all calling
+ * move_velocity / move_relative on the same motor from different tasks, every
+ * call serializes on the VDML port mutex and the commands interleave in
+ * whatever order the scheduler happens to run — we have seen a stall-recovery
+ * reversal fight an ejection stop on the same port.
+ *
+ * Here exactly one drain step owns the motor. Producers enqueue commands into
+ * per-task single-producer/single-consumer rings (lock-free: one atomic index
+ * per side, no mutex), and the owner drains them with explicit authority
+ * rules — stall recovery outranks ejection outranks driver hold — and
+ * coalesces redundant same-velocity writes so they never hit the serial bus.
+ */
+
+/**
+ * @brief Command priority classes, lowest to highest.
+ * @details A command from a lower class is dropped while a higher class holds
+ * authority; authority is returned by an explicit release command.
+ */
+enum MotorCommandSource
+{
+    SOURCE_DRIVER = 0,  // Default driver/opcontrol commands
+    SOURCE_EJECT = 1,   // Color-sort ejection stops and resumes
+    SOURCE_RECOVERY = 2 // Stall recovery; outranks everything
+};
+
+/**
+ * @brief What a queued command asks the motor to do.
+ */
+enum MotorCommandKind
+{
+    CMD_VELOCITY, // move_velocity(value)
+    CMD_RELATIVE, // move_relative(value, speed)
+    CMD_RELEASE   // No motor action; returns authority to SOURCE_DRIVER
+};
+
+/**
+ * @brief One queued motor command.
+ */
+struct MotorCommand
+{
+    MotorCommandKind kind;     // Action to perform
+    MotorCommandSource source; // Priority class of the producer
+    double value;              // Velocity (RPM) or relative degrees
+    double speed;              // Speed for CMD_RELATIVE; unused otherwise
+};
+
+/**
+ * @brief Fixed-capacity lock-free single-producer/single-consumer ring.
+ * @tparam T Element type (trivially copyable).
+ * @tparam Capacity Power-of-two slot count.
+ */
+template <typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two for mask indexing");
+
+public:
+    /**
+     * @brief Enqueues an element; producer side only.
+     * @return false if the ring is full (the command is dropped).
+     */
+    bool push(const T &item)
+    {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        std::size_t tail = tail_.load(std::memory_order_acquire);
+        if (head - tail >= Capacity)
+        {
+            return false; // Full
+        }
+        slots_[head & MASK] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeues an element; consumer side only.
+     * @return false if the ring is empty.
+     */
+    bool pop(T &item)
+    {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t head = head_.load(std::memory_order_acquire);
+        if (tail == head)
+        {
+            return false; // Empty
+        }
+        item = slots_[tail & MASK];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    T slots_[Capacity];                // Element storage
+    std::atomic<std::size_t> head_{0}; // Written by the producer
+    std::atomic<std::size_t> tail_{0}; // Written by the consumer
+};
+
+/**
+ * @brief The single authority over one motor.
+ *
+ * Each producer task opens its own channel (keeping every ring strictly
+ * SPSC) and enqueues commands; drainStep — registered on the poll scheduler —
+ * is the only code that actually touches the motor.
+ */
+class MotorOwner
+{
+public:
+    /**
+     * @brief Maximum producer channels (tasks) per motor.
+     */
+    static constexpr int MAX_CHANNELS = 4;
+
+    /**
+     * @brief Commands buffered per channel.
+     */
+    static constexpr std::size_t QUEUE_DEPTH = 8;
+
+    /**
+     * @brief Period (ms) to register drainStep at; commands reach the motor
+     * within one drain period of being enqueued.
+     */
+    static constexpr uint32_t DRAIN_PERIOD_MS = 2;
+
+    /**
+     * @brief Takes ownership of a motor. No other code should command it.
+     */
+    explicit MotorOwner(pros::Motor &motor)
+        : motor_(motor)
+    {
+    }
+
+    /**
+     * @brief Opens a command channel for one producer task.
+     * @return Channel handle, or -1 if all channels are taken.
+     */
+    int openChannel()
+    {
+        if (channel_count_ >= MAX_CHANNELS)
+        {
+            return -1;
+        }
+        return channel_count_++;
+    }
+
+    /**
+     * @brief Enqueues a velocity command.
+     */
+    bool sendVelocity(int channel, MotorCommandSource source, double rpm)
+    {
+        return send(channel, {CMD_VELOCITY, source, rpm, 0.0});
+    }
+
+    /**
+     * @brief Enqueues a relative-move command.
+     */
+    bool sendRelative(int channel, MotorCommandSource source, double degrees, double speed)
+    {
+        return send(channel, {CMD_RELATIVE, source, degrees, speed});
+    }
+
+    /**
+     * @brief Returns a source's authority so lower-priority producers (the
+     * driver) regain control of the motor.
+     */
+    bool sendRelease(int channel, MotorCommandSource source)
+    {
+        return send(channel, {CMD_RELEASE, source, 0.0, 0.0});
+    }
+
+    /**
+     * @brief Enqueues a raw command on a channel.
+     */
+    bool send(int channel, const MotorCommand &cmd)
+    {
+        if (channel < 0 || channel >= channel_count_)
+        {
+            return false;
+        }
+        return queues_[channel].push(cmd);
+    }
+
+    /**
+     * @brief Drains every channel and applies commands to the motor.
+     *
+     * Register on the poll scheduler at DRAIN_PERIOD_MS. Commands from a
+     * source below the current authority are dropped; a command from an equal
+     * or higher source takes (or keeps) authority. Velocity commands equal to
+     * the last applied velocity are coalesced away without a device call.
+     */
+    void drainStep()
+    {
+        MotorCommand cmd;
+        for (int channel = 0; channel < channel_count_; channel++)
+        {
+            while (queues_[channel].pop(cmd))
+            {
+                apply(cmd);
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief Applies one command under the authority and coalescing rules.
+     */
+    void apply(const MotorCommand &cmd)
+    {
+        if (cmd.kind == CMD_RELEASE)
+        {
+            // Only the holder (or a higher source) can release authority
+            if (cmd.source >= authority_)
+            {
+                authority_ = SOURCE_DRIVER;
+            }
+            return;
+        }
+
+        if (cmd.source < authority_)
+        {
+            return; // Preempted: a higher-priority sequence is in flight
+        }
+        authority_ = cmd.source;
+
+        switch (cmd.kind)
+        {
+        case CMD_VELOCITY:
+            // Coalesce: a velocity we already hold never hits the serial bus
+            if (!have_last_velocity_ || last_velocity_ != cmd.value)
+            {
+                motor_.move_velocity(cmd.value);
+                last_velocity_ = cmd.value;
+                have_last_velocity_ = true;
+            }
+            break;
+
+        case CMD_RELATIVE:
+            motor_.move_relative(cmd.value, cmd.speed);
+            have_last_velocity_ = false; // Profile move invalidates held velocity
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    pros::Motor &motor_;                             // The owned motor
+    SpscRing<MotorCommand, QUEUE_DEPTH> queues_[MAX_CHANNELS]; // One SPSC ring per producer
+    int channel_count_ = 0;                          // Opened channels
+    MotorCommandSource authority_ = SOURCE_DRIVER;   // Current priority holder
+    double last_velocity_ = 0.0;                     // Last applied velocity
+    bool have_last_velocity_ = false;                // Whether last_velocity_ is valid
+};
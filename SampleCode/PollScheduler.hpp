@@ -0,0 +1,326 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include "StaticTask.hpp"
+#include <cstdint>
+
+/**
+ * @file PollScheduler.hpp
+ * @brief Single-task cooperative scheduler for periodic sensor-polling callbacks.
+ *
+ * Running every feature (color sorting, stall monitoring, ...) as its own
+ * pros::Task costs a multi-KB stack and context switches per feature — the
+ * scarcest resources on a V5 brain. This scheduler runs all registered
+ * callbacks from one task and one stack: each callback declares its own
+ * period (e.g. color sort every 2 ms, stall monitor every 20 ms), deadlines
+ * are tracked in absolute time so periods do not drift, and per-callback
+ * execution time is recorded so you can see which handler is hogging the frame.
+ *
+ * Callbacks must be non-blocking step functions: do one iteration's work and
+ * return. A callback that sleeps or busy-waits stalls every other callback.
+ */
+class PollScheduler
+{
+public:
+    /**
+     * @brief Maximum number of registered callbacks.
+     */
+    static constexpr int MAX_CALLBACKS = 12;
+
+    /**
+     * @brief Base tick of the scheduler loop in milliseconds.
+     * @details Also the finest callback period the scheduler can honor.
+     */
+    static constexpr uint32_t TICK_MS = 1;
+
+    /**
+     * @brief Longest the loop sleeps when no callback is due soon.
+     * @details The loop sleeps to the nearest enabled deadline rather than
+     * waking every tick, so an idled-down program wakes a few times per
+     * cap interval instead of a thousand times a second. The cap keeps
+     * heartbeat gaps well under any attached watchdog's deadline.
+     */
+    static constexpr uint32_t IDLE_SLEEP_CAP_MS = 5;
+
+    /**
+     * @brief A non-blocking periodic step function.
+     */
+    using Callback = void (*)();
+
+    /**
+     * @brief Registers a periodic callback.
+     *
+     * @param name Short label used when reporting execution times.
+     * @param fn The step function to run.
+     * @param period_ms Desired period in milliseconds (>= TICK_MS).
+     * @param enabled Whether the callback starts enabled.
+     * @return Handle for later period/enable changes, or -1 if the table is full.
+     */
+    int add(const char *name, Callback fn, uint32_t period_ms, bool enabled = true)
+    {
+        if (count_ >= MAX_CALLBACKS)
+        {
+            return -1;
+        }
+        Slot &slot = slots_[count_];
+        slot.name = name;
+        slot.fn = fn;
+        slot.period_ms = period_ms;
+        slot.next_due_ms = pros::millis();
+        slot.enabled = enabled;
+        slot.last_us = 0;
+        slot.worst_us = 0;
+        slot.slips = 0;
+        slot.total_us = 0;
+        return count_++;
+    }
+
+    /**
+     * @brief Changes a callback's period.
+     * @details Lengthening takes effect at the next deadline; shortening
+     * pulls a pending deadline in, so a rate increase (e.g. a duty-cycle
+     * governor ramping out of deep idle) takes effect within one period of
+     * the new rate instead of waiting out the old interval.
+     */
+    void setPeriod(int handle, uint32_t period_ms)
+    {
+        if (handle >= 0 && handle < count_)
+        {
+            Slot &slot = slots_[handle];
+            slot.period_ms = period_ms;
+            uint32_t due = pros::millis() + period_ms;
+            if (slot.next_due_ms > due)
+            {
+                slot.next_due_ms = due;
+            }
+        }
+    }
+
+    /**
+     * @brief Enables or disables a callback without unregistering it.
+     * @details Re-enabling resets the deadline to "due now", so the callback
+     * runs within one scheduler tick.
+     */
+    void setEnabled(int handle, bool enabled)
+    {
+        if (handle >= 0 && handle < count_)
+        {
+            if (enabled && !slots_[handle].enabled)
+            {
+                slots_[handle].next_due_ms = pros::millis();
+            }
+            slots_[handle].enabled = enabled;
+        }
+    }
+
+    /**
+     * @brief Whether a callback is currently enabled.
+     */
+    bool isEnabled(int handle) const
+    {
+        return handle >= 0 && handle < count_ && slots_[handle].enabled;
+    }
+
+    /**
+     * @brief Execution time (µs) of a callback's most recent run.
+     */
+    uint32_t lastRunUs(int handle) const
+    {
+        return (handle >= 0 && handle < count_) ? slots_[handle].last_us : 0;
+    }
+
+    /**
+     * @brief Worst execution time (µs) a callback has shown since registration.
+     * @details The fastest way to find which handler is blowing the frame budget.
+     */
+    uint32_t worstRunUs(int handle) const
+    {
+        return (handle >= 0 && handle < count_) ? slots_[handle].worst_us : 0;
+    }
+
+    /**
+     * @brief Stack depth for the scheduler task. The callbacks are shallow
+     * polling steps, so half the PROS default is comfortable.
+     */
+    static constexpr uint16_t STACK_DEPTH = 0x1000;
+
+    /**
+     * @brief Priority of the scheduler task.
+     * @details One above default: the sensor/control callbacks must not be
+     * starved by miscellaneous default-priority code, but stay below the
+     * watchdog so starvation is still observable.
+     */
+    static constexpr uint32_t TASK_PRIORITY = TASK_PRIORITY_DEFAULT + 1;
+
+    /**
+     * @brief Starts the scheduler task. Call once after registering callbacks.
+     */
+    void start()
+    {
+        task_.start(trampoline, this, "Poll Scheduler", TASK_PRIORITY);
+    }
+
+    /**
+     * @brief Points the scheduler at a heartbeat word (e.g. from a Watchdog)
+     * that it stamps with pros::millis() every tick.
+     */
+    void setHeartbeatSlot(volatile uint32_t *slot)
+    {
+        heartbeat_ = slot;
+    }
+
+    /**
+     * @brief The underlying task, e.g. for a watchdog to bump its priority.
+     * @return nullptr until start() has run.
+     */
+    pros::Task *task()
+    {
+        return task_.get();
+    }
+
+    /**
+     * @brief Times a callback fell a full period behind and was resynced.
+     */
+    uint32_t slipCount(int handle) const
+    {
+        return (handle >= 0 && handle < count_) ? slots_[handle].slips : 0;
+    }
+
+    /**
+     * @brief Accumulated execution time (µs) of one callback.
+     */
+    uint64_t totalRunUs(int handle) const
+    {
+        return (handle >= 0 && handle < count_) ? slots_[handle].total_us : 0;
+    }
+
+    /**
+     * @brief Loop slips summed over every callback.
+     */
+    uint32_t totalSlips() const
+    {
+        uint32_t total = 0;
+        for (int i = 0; i < count_; i++)
+        {
+            total += slots_[i].slips;
+        }
+        return total;
+    }
+
+    /**
+     * @brief CPU time (µs) summed over every callback.
+     */
+    uint64_t totalCpuUs() const
+    {
+        uint64_t total = 0;
+        for (int i = 0; i < count_; i++)
+        {
+            total += slots_[i].total_us;
+        }
+        return total;
+    }
+
+private:
+    /**
+     * @brief Bookkeeping for one registered callback.
+     */
+    struct Slot
+    {
+        const char *name;     // Label for reporting
+        Callback fn;          // The step function
+        uint32_t period_ms;   // Desired period
+        uint32_t next_due_ms; // Absolute deadline of the next run
+        bool enabled;         // Skipped entirely while false
+        uint32_t last_us;     // Execution time of the most recent run
+        uint32_t worst_us;    // Worst execution time observed
+        uint32_t slips;       // Times the callback fell a period behind
+        uint64_t total_us;    // Accumulated execution time (CPU accounting)
+    };
+
+    /**
+     * @brief pros::Task entry point; unpacks the scheduler instance.
+     */
+    static void trampoline(void *self)
+    {
+        static_cast<PollScheduler *>(self)->run();
+    }
+
+    /**
+     * @brief The scheduler loop: runs due callbacks, then sleeps to the next
+     * absolute tick via delay_until so the cadence never drifts.
+     */
+    void run()
+    {
+        uint32_t now = pros::millis();
+        for (int i = 0; i < count_; i++)
+        {
+            slots_[i].next_due_ms = now; // First run happens on the first tick
+        }
+
+        while (true)
+        {
+            for (int i = 0; i < count_; i++)
+            {
+                Slot &slot = slots_[i];
+                if (!slot.enabled || pros::millis() < slot.next_due_ms)
+                {
+                    continue;
+                }
+
+                // Time the callback so frame hogs are visible
+                uint64_t start_us = pros::micros();
+                slot.fn();
+                uint32_t elapsed = static_cast<uint32_t>(pros::micros() - start_us);
+                slot.last_us = elapsed;
+                slot.total_us += elapsed;
+                if (elapsed > slot.worst_us)
+                {
+                    slot.worst_us = elapsed;
+                }
+
+                // Advance by the period (not "now + period") so a late run
+                // does not shift the cadence; if we fell more than one period
+                // behind, resynchronize instead of bursting to catch up.
+                slot.next_due_ms += slot.period_ms;
+                if (slot.next_due_ms <= pros::millis())
+                {
+                    slot.slips++; // A full period was lost; count the slip
+                    slot.next_due_ms = pros::millis() + slot.period_ms;
+                }
+            }
+
+            // Check in with the watchdog (if one is attached)
+            if (heartbeat_ != nullptr)
+            {
+                *heartbeat_ = pros::millis();
+            }
+
+            // Sleep to the nearest enabled deadline (capped for heartbeat
+            // freshness) instead of a fixed tick: deep idle for free when
+            // every callback is parked at a long period or disabled
+            uint32_t sleep_ms = IDLE_SLEEP_CAP_MS;
+            uint32_t now_ms = pros::millis();
+            for (int i = 0; i < count_; i++)
+            {
+                const Slot &slot = slots_[i];
+                if (!slot.enabled)
+                {
+                    continue;
+                }
+                uint32_t gap = slot.next_due_ms > now_ms ? slot.next_due_ms - now_ms : TICK_MS;
+                if (gap < sleep_ms)
+                {
+                    sleep_ms = gap;
+                }
+            }
+
+            // Absolute-time sleep: drift-free even if callbacks ran long
+            pros::Task::delay_until(&now, sleep_ms);
+        }
+    }
+
+    Slot slots_[MAX_CALLBACKS];     // Fixed callback table; no heap
+    int count_ = 0;                 // Registered callbacks
+    StaticTask<STACK_DEPTH> task_;  // The single scheduler task; heap-free lifecycle
+    volatile uint32_t *heartbeat_ = nullptr; // Watchdog check-in word, if attached
+};
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "TelemetrySnapshot.hpp"
+#include "MotorCommandQueue.hpp" // SpscRing
+#include "StaticTask.hpp"
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @file Replay.hpp
+ * @brief Record/replay of telemetry so detection logic can be tuned off-robot.
+ *
+ * Tuning timing constants (travel distance, stop windows, hue bands, stall
+ * slopes) on a physical robot costs field time per experiment. Because every
+ * consumer in this repo already reads devices exclusively through
+ * TelemetrySnapshot, the snapshot stream *is* the device interface — record
+ * it during a practice run and any snapshot consumer can be re-driven from
+ * the recording, off-hardware, as fast as the CPU can iterate.
+ *
+ * Robot side: TelemetryRecorder packs each collected snapshot into a 28-byte
+ * frame and streams it to /usd/telemetry.bin the same way Trace streams its
+ * events — lock-free ring on the hot path, batched writes from a dedicated
+ * low-priority flush task (SD latency spikes must never ride the scheduler
+ * task). At the 10 ms collection cadence this is ~3 KB/s of SD traffic.
+ *
+ * Host side: ReplayTelemetry loads a recording and presents the same read()/
+ * objectPresent() surface as TelemetryCollector, advancing one frame per
+ * step() at virtual time taken from the recorded timestamps — thousands of
+ * simulated seconds per wall-clock second, no sleeping. To run colorSortStep
+ * or intakeMonitorStep against it on a desktop, compile the sample with a
+ * small PROS shim (millis/micros forwarding to ReplayTelemetry::virtualMillis,
+ * no-op display and motor stubs) and swap the collector global for a
+ * ReplayTelemetry; this repo ships no build manifest, so assembling that
+ * harness target is left to the consuming project.
+ */
+
+/**
+ * @brief One recorded telemetry frame; 28 bytes, written verbatim.
+ * @details Field order is the file format — never reorder; add new fields at
+ * the end of the struct and bump VERSION in the recorder.
+ */
+struct ReplayFrame
+{
+    uint32_t timestamp_ms; // Snapshot collection time
+    float velocity;        // Intake actual velocity (RPM)
+    float target;          // Intake commanded velocity (RPM)
+    float position;        // Intake encoder position (degrees)
+    float hue;             // Optical hue (degrees); valid per flags
+    int16_t current;       // Intake current draw (mA)
+    uint8_t proximity;     // Optical proximity (0-255)
+    uint8_t flags;         // Bit 0: hue_valid; bits 1-2: intake_ok/optical_ok
+    uint32_t generation;   // Motor state generation, for dedup on replay
+};
+
+static_assert(sizeof(ReplayFrame) == 28,
+              "ReplayFrame layout drifted; update the host-side reader");
+
+/**
+ * @brief Robot-side recorder: feeds frames into a ring on the hot path and
+ * streams them to the SD card from a flusher callback.
+ */
+class TelemetryRecorder
+{
+public:
+    /**
+     * @brief Frames buffered between flushes (one second of headroom at the
+     * burst collection rate).
+     */
+    static constexpr std::size_t CAPACITY = 512;
+
+    /**
+     * @brief Period (ms) between flushes of the dedicated flush task.
+     */
+    static constexpr uint32_t FLUSH_PERIOD_MS = 100;
+
+    /**
+     * @brief Stack depth for the flush task: a drain loop and stdio buffers.
+     */
+    static constexpr uint16_t FLUSH_STACK_DEPTH = 0x800;
+
+    /**
+     * @brief Priority below default, like the trace flusher: this is the
+     * one job here that may block on the SD card.
+     */
+    static constexpr uint32_t FLUSH_TASK_PRIORITY = TASK_PRIORITY_DEFAULT - 1;
+
+    /**
+     * @brief File format version, first 4 bytes of the recording.
+     */
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @brief Packs and buffers one snapshot; call from the telemetry step.
+     * Hot-path safe: a pack plus one ring push, no I/O.
+     */
+    static void feed(const TelemetrySnapshot &snap)
+    {
+        ReplayFrame frame;
+        frame.timestamp_ms = snap.timestamp_ms;
+        frame.velocity = static_cast<float>(snap.intake.velocity);
+        frame.target = static_cast<float>(snap.intake.target);
+        frame.position = static_cast<float>(snap.intake.position);
+        frame.hue = static_cast<float>(snap.hue);
+        frame.current = static_cast<int16_t>(snap.intake.current);
+        frame.proximity = static_cast<uint8_t>(snap.proximity);
+        frame.flags = static_cast<uint8_t>((snap.hue_valid ? 1 : 0) |
+                                           (snap.intake_ok ? 2 : 0) |
+                                           (snap.optical_ok ? 4 : 0));
+        frame.generation = snap.intake.generation;
+        ring().push(frame); // Full ring drops the frame; replay gaps are benign
+    }
+
+    /**
+     * @brief Starts the dedicated flush task. Call once when recording is
+     * enabled; safe to call again (the extra call is a no-op).
+     */
+    static void startFlushTask()
+    {
+        flushTask().start(flushLoop, nullptr, "Telemetry Log", FLUSH_TASK_PRIORITY);
+    }
+
+    /**
+     * @brief Drains buffered frames to /usd/telemetry.bin in one batched
+     * fwrite. Runs on the dedicated flush task — never register it on the
+     * poll scheduler, because it blocks on SD latency.
+     */
+    static void flushStep()
+    {
+        static FILE *file = openRecording();
+        ReplayFrame batch[64];
+        std::size_t count = 0;
+        while (count < 64 && ring().pop(batch[count]))
+        {
+            count++;
+        }
+        if (count > 0 && file != nullptr)
+        {
+            fwrite(batch, sizeof(ReplayFrame), count, file);
+            fflush(file);
+        }
+    }
+
+private:
+    /**
+     * @brief The flush task body: drain, sleep, repeat.
+     */
+    static void flushLoop(void *)
+    {
+        uint32_t now = pros::millis();
+        while (true)
+        {
+            flushStep();
+            pros::Task::delay_until(&now, FLUSH_PERIOD_MS);
+        }
+    }
+
+    /**
+     * @brief The flush task slot (function-local static: no ordering issues
+     * with global constructors).
+     */
+    static StaticTask<FLUSH_STACK_DEPTH> &flushTask()
+    {
+        static StaticTask<FLUSH_STACK_DEPTH> instance;
+        return instance;
+    }
+
+    /**
+     * @brief Opens the recording and writes the version header.
+     */
+    static FILE *openRecording()
+    {
+        FILE *file = fopen("/usd/telemetry.bin", "wb");
+        if (file != nullptr)
+        {
+            uint32_t version = VERSION;
+            fwrite(&version, sizeof(version), 1, file);
+        }
+        return file;
+    }
+
+    /**
+     * @brief The preallocated frame ring (function-local static: no ordering
+     * issues with global constructors).
+     */
+    static SpscRing<ReplayFrame, CAPACITY> &ring()
+    {
+        static SpscRing<ReplayFrame, CAPACITY> instance;
+        return instance;
+    }
+};
+
+/**
+ * @brief Replay-side snapshot source: the same read surface as
+ * TelemetryCollector, fed from a recording at virtual time.
+ *
+ * Drive it from a loop: while (replay.step()) { colorSortStepUnderTest(); }.
+ * Each step() publishes the next recorded frame and advances virtualMillis()
+ * to its timestamp, so a 105-second match replays in however long the logic
+ * under test takes to run — typically well under a second.
+ */
+class ReplayTelemetry
+{
+public:
+    /**
+     * @brief Wires the replay to a frame array, e.g. a recording read into
+     * memory by the host harness (skip the 4-byte version header first).
+     */
+    ReplayTelemetry(const ReplayFrame *frames, std::size_t count)
+        : frames_(frames), count_(count)
+    {
+    }
+
+    /**
+     * @brief Publishes the next frame; false when the recording is exhausted.
+     */
+    bool step()
+    {
+        if (next_ >= count_)
+        {
+            return false;
+        }
+        const ReplayFrame &frame = frames_[next_++];
+        snap_.timestamp_ms = frame.timestamp_ms;
+        snap_.intake.velocity = frame.velocity;
+        snap_.intake.target = frame.target;
+        snap_.intake.position = frame.position;
+        snap_.intake.current = frame.current;
+        snap_.intake.generation = frame.generation;
+        snap_.hue = frame.hue;
+        snap_.proximity = frame.proximity;
+        snap_.hue_valid = (frame.flags & 1) != 0;
+        snap_.intake_ok = (frame.flags & 2) != 0;
+        snap_.optical_ok = (frame.flags & 4) != 0;
+        return true;
+    }
+
+    /**
+     * @brief The current snapshot; same contract as TelemetryCollector::read.
+     */
+    TelemetrySnapshot read() const
+    {
+        return snap_;
+    }
+
+    /**
+     * @brief Same contract as TelemetryCollector::objectPresent.
+     */
+    bool objectPresent() const
+    {
+        return snap_.hue_valid;
+    }
+
+    /**
+     * @brief Virtual time (ms) of the current frame; the host harness's
+     * millis() shim should forward here so timestamp-driven state machines
+     * run against replay time instead of wall time.
+     */
+    uint32_t virtualMillis() const
+    {
+        return snap_.timestamp_ms;
+    }
+
+private:
+    const ReplayFrame *frames_; // The loaded recording; not owned
+    std::size_t count_;         // Frames in the recording
+    std::size_t next_ = 0;      // Next frame to publish
+    TelemetrySnapshot snap_;    // The currently published snapshot
+};
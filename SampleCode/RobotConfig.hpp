@@ -0,0 +1,94 @@
+#pragma once
+
+#include "pros/misc.hpp"
+#include "pros/motors.hpp"
+#include "pros/optical.hpp"
+#include <cstdint>
+
+/**
+ * @file RobotConfig.hpp
+ * @brief Compile-time robot configuration for the samples in this repo.
+ *
+ * The ColorSort sample used to assume colorSortSensor, intake, and
+ * mainController were defined "somewhere else" and resolved at runtime. Here
+ * the configuration is carried in template parameters instead: port numbers
+ * and gearsets are compile-time constants with static_asserts catching bad
+ * ports at build time, derived values (like the gearset's free speed) are
+ * constexpr so dead configuration branches fold away, and the devices are
+ * plain globals constructed once from those constants — no runtime lookup,
+ * no indirection, and nothing measurable added to brain boot inside the
+ * ~3-second window field control gives before auton.
+ *
+ * PROS device objects themselves are not constexpr-constructible, so the
+ * compile-time layer is the configuration; the device definitions at the
+ * bottom are the only runtime objects.
+ */
+
+/**
+ * @brief A validated V5 smart port carried as a template parameter.
+ * @tparam PortNum Smart port number, 1-21.
+ */
+template <std::uint8_t PortNum>
+struct Port
+{
+    static_assert(PortNum >= 1 && PortNum <= 21, "V5 smart ports are 1-21");
+    static constexpr std::uint8_t value = PortNum;
+};
+
+/**
+ * @brief Compile-time motor configuration: port plus gearset.
+ * @tparam PortT A Port<> instantiation.
+ * @tparam Gearset The installed motor cartridge.
+ */
+template <typename PortT, pros::motor_gearset_e_t Gearset>
+struct MotorConfig
+{
+    static constexpr std::uint8_t PORT = PortT::value;
+    static constexpr pros::motor_gearset_e_t GEARSET = Gearset;
+
+    /**
+     * @brief Free speed (RPM) of the configured cartridge, usable in
+     * constexpr context (e.g. sizing velocity envelopes at compile time).
+     */
+    static constexpr double maxRpm()
+    {
+        return Gearset == pros::E_MOTOR_GEARSET_36   ? 100.0
+               : Gearset == pros::E_MOTOR_GEARSET_18 ? 200.0
+                                                     : 600.0;
+    }
+};
+
+/**
+ * @brief Compile-time optical sensor configuration.
+ * @tparam PortT A Port<> instantiation.
+ */
+template <typename PortT>
+struct OpticalConfig
+{
+    static constexpr std::uint8_t PORT = PortT::value;
+};
+
+/**
+ * @brief The robot: edit the template arguments here to rewire it.
+ * @details Everything downstream picks the change up at compile time.
+ */
+struct RobotConfig
+{
+    using Intake = MotorConfig<Port<1>, pros::E_MOTOR_GEARSET_06>;
+    using ColorSensor = OpticalConfig<Port<2>>;
+};
+
+/**
+ * @brief The intake motor, built from its compile-time configuration.
+ */
+inline pros::Motor intake(RobotConfig::Intake::PORT, RobotConfig::Intake::GEARSET);
+
+/**
+ * @brief The color sorting sensor, built from its compile-time configuration.
+ */
+inline pros::Optical colorSortSensor(RobotConfig::ColorSensor::PORT);
+
+/**
+ * @brief The primary driver controller.
+ */
+inline pros::Controller mainController(pros::E_CONTROLLER_MASTER);
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "TelemetrySnapshot.hpp"
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * @file StallDetector.hpp
+ * @brief Predictive intake stall detection from current and velocity slopes.
+ *
+ * The original monitor waited out a fixed 1000 ms spin-up grace and then
+ * compared raw velocity against a threshold — by the time that fires, a jam
+ * has had a full second to wedge the ring deeper and recovery takes longer.
+ *
+ * This detector instead watches the telemetry snapshot over a short rolling
+ * window and recognizes the signature of an incipient stall — rising current
+ * draw with falling velocity — within roughly 50 ms of onset. The fixed grace
+ * period is replaced by model-based spin-up tracking: detection arms the
+ * moment the motor reaches its commanded-velocity envelope, and a jam during
+ * spin-up itself (high current, no acceleration) is caught too.
+ */
+class StallDetector
+{
+public:
+    /**
+     * @brief Snapshot samples kept in the rolling window.
+     * @details Five samples at the 10 ms telemetry cadence give a 50 ms
+     * window for the slope estimates.
+     */
+    static constexpr int WINDOW = 5;
+
+    /**
+     * @brief Fraction of the commanded velocity the motor must reach for
+     * spin-up to be considered complete and detection to arm.
+     */
+    static constexpr double ARM_FRACTION = 0.8;
+
+    /**
+     * @brief Current draw (mA) above which the motor is working hard enough
+     * for a stall signature to be credible. A V5 11 W motor limits at ~2500 mA.
+     */
+    static constexpr int STALL_CURRENT_MA = 2000;
+
+    /**
+     * @brief Velocity slope (RPM per second) below which velocity counts as
+     * falling for the stall signature.
+     */
+    static constexpr double FALLING_SLOPE_RPM_PER_S = -200.0;
+
+    /**
+     * @brief Hard cap (ms) on spin-up: if the motor has not reached its
+     * envelope by then, something is wrong and detection arms anyway.
+     */
+    static constexpr uint32_t SPIN_UP_TIMEOUT_MS = 1000;
+
+    /**
+     * @brief Margin (ms) added to the learned spin-up time when it replaces
+     * the worst-case cap on warm re-arms.
+     */
+    static constexpr uint32_t SPIN_UP_MARGIN_MS = 100;
+
+    /**
+     * @brief Cold-start reset: clears the rolling window and forgets the
+     * learned spin-up envelope. Use when the program starts or the intake
+     * hardware may have changed (e.g. after clearing a jam by hand).
+     */
+    void reset()
+    {
+        rearm();
+        learned_spin_up_ms_ = 0;
+    }
+
+    /**
+     * @brief Warm re-arm: clears the rolling window for a fresh spin-up but
+     * retains the learned envelope from earlier runs.
+     * @details Used on every driver toggle. Because the time-to-envelope
+     * measured on the cold start is remembered, the spin-up cap for a warm
+     * start is that measurement plus margin rather than the 1 s worst case —
+     * stall protection is back within roughly one real spin-up.
+     */
+    void rearm()
+    {
+        count_ = 0;
+        head_ = 0;
+        armed_ = false;
+        spin_up_start_ms_ = 0;
+    }
+
+    /**
+     * @brief Velocity envelope check: has the motor reached the given
+     * fraction of its commanded velocity?
+     * @tparam Math Arithmetic type: double (the default path on V5) or Fixed
+     * from FixedPoint.hpp for FPU-less coprocessor ports. The benchmark
+     * target A/B's the two instantiations.
+     */
+    template <typename Math>
+    static bool envelopeReached(Math velocity, Math target, Math fraction)
+    {
+        Math zero = Math();
+        Math speed = velocity < zero ? -velocity : velocity;
+        Math commanded = target < zero ? -target : target;
+        return commanded > zero && speed >= fraction * commanded;
+    }
+
+    /**
+     * @brief Seeds the learned spin-up time, e.g. from the calibration cache,
+     * so even the cold start uses a measured envelope instead of the
+     * worst-case cap.
+     */
+    void seedSpinUp(uint32_t spin_up_ms)
+    {
+        if (spin_up_ms > 0)
+        {
+            learned_spin_up_ms_ = spin_up_ms;
+        }
+    }
+
+    /**
+     * @brief Feeds one telemetry snapshot; call once per monitor iteration.
+     * @details Duplicate snapshots (same timestamp) are ignored, so calling
+     * faster than the telemetry cadence is harmless.
+     */
+    void update(const TelemetrySnapshot &snap)
+    {
+        if (count_ > 0 && snap.intake.generation == newest().intake.generation)
+        {
+            return; // Same generation: telemetry has not refreshed yet
+        }
+
+        if (spin_up_start_ms_ == 0)
+        {
+            spin_up_start_ms_ = snap.timestamp_ms; // First sample after reset
+        }
+
+        // Insert into the rolling window (overwrites the oldest when full)
+        history_[head_] = snap;
+        head_ = (head_ + 1) % WINDOW;
+        if (count_ < WINDOW)
+        {
+            count_++;
+        }
+
+        // Model-based spin-up tracking: arm as soon as the motor enters its
+        // commanded-velocity envelope, or when the spin-up cap expires. A
+        // previously learned spin-up time tightens the cap on warm re-arms.
+        if (!armed_)
+        {
+            uint32_t elapsed = snap.timestamp_ms - spin_up_start_ms_;
+            if (envelopeReached(snap.intake.velocity, snap.intake.target, ARM_FRACTION))
+            {
+                armed_ = true;
+                // Remember how long a healthy spin-up takes on this intake
+                if (learned_spin_up_ms_ == 0 || elapsed < learned_spin_up_ms_)
+                {
+                    learned_spin_up_ms_ = elapsed;
+                }
+            }
+            else if (elapsed >= spinUpCapMs())
+            {
+                armed_ = true;
+            }
+        }
+    }
+
+    /**
+     * @brief Current spin-up cap (ms): the learned envelope time plus margin
+     * once one has been measured, the worst-case default before that.
+     */
+    uint32_t spinUpCapMs() const
+    {
+        return learned_spin_up_ms_ > 0 ? learned_spin_up_ms_ + SPIN_UP_MARGIN_MS
+                                       : SPIN_UP_TIMEOUT_MS;
+    }
+
+    /**
+     * @brief Whether detection is armed (spin-up complete or timed out).
+     */
+    bool armed() const
+    {
+        return armed_;
+    }
+
+    /**
+     * @brief Whether the rolling window currently shows a stall signature.
+     *
+     * Armed phase: rising current with falling velocity, or velocity already
+     * collapsed while the motor is still being commanded and drawing current.
+     * Spin-up phase: heavy current with no acceleration — a jam at startup.
+     */
+    bool stallDetected() const
+    {
+        if (count_ < WINDOW)
+        {
+            return false; // Not enough history for a slope estimate yet
+        }
+
+        const TelemetrySnapshot &newest_snap = newest();
+        const TelemetrySnapshot &oldest_snap = oldest();
+        if (newest_snap.intake.target == 0.0)
+        {
+            return false; // Motor is intentionally stopped
+        }
+
+        double dt_s = (newest_snap.timestamp_ms - oldest_snap.timestamp_ms) / 1000.0;
+        if (dt_s <= 0.0)
+        {
+            return false;
+        }
+        double velocity_slope = (std::abs(newest_snap.intake.velocity) -
+                                 std::abs(oldest_snap.intake.velocity)) / dt_s;
+        bool current_rising = newest_snap.intake.current > oldest_snap.intake.current;
+        bool current_heavy = newest_snap.intake.current >= STALL_CURRENT_MA;
+
+        if (!armed_)
+        {
+            // Jam during spin-up: drawing stall-level current but not accelerating
+            return current_heavy && velocity_slope <= 0.0;
+        }
+
+        // Incipient stall: load is climbing while the motor loses speed
+        if (current_rising && current_heavy && velocity_slope <= FALLING_SLOPE_RPM_PER_S)
+        {
+            return true;
+        }
+
+        // Fully developed stall: velocity has already collapsed under load
+        return current_heavy &&
+               std::abs(newest_snap.intake.velocity) < ARM_FRACTION * 0.25 * std::abs(newest_snap.intake.target);
+    }
+
+private:
+    /**
+     * @brief Most recently inserted snapshot. Only valid when count_ > 0.
+     */
+    const TelemetrySnapshot &newest() const
+    {
+        return history_[(head_ + WINDOW - 1) % WINDOW];
+    }
+
+    /**
+     * @brief Oldest snapshot in the window. Only valid when count_ == WINDOW.
+     */
+    const TelemetrySnapshot &oldest() const
+    {
+        return history_[head_];
+    }
+
+    TelemetrySnapshot history_[WINDOW]; // Rolling window of snapshots
+    int head_ = 0;                      // Next insert position
+    int count_ = 0;                     // Valid entries in the window
+    bool armed_ = false;                // Spin-up complete (or timed out)
+    uint32_t spin_up_start_ms_ = 0;     // Timestamp of the first post-reset sample
+    uint32_t learned_spin_up_ms_ = 0;   // Measured healthy time-to-envelope; 0 = unknown
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include <cstdint>
+#include <optional>
+
+/**
+ * @file StaticTask.hpp
+ * @brief Heap-free, reusable pros::Task lifecycle wrapper with tuned stacks.
+ *
+ * The original start/stop helpers did `new pros::Task(...)` and `delete` on
+ * every driver toggle — dozens of times per match — and that churn fragments
+ * the V5 allocator over a long practice session. This wrapper keeps the task
+ * handle in preallocated storage (std::optional placement construction, no
+ * heap from our code) and lets each task declare its own stack depth instead
+ * of inheriting the oversized default.
+ *
+ * PROS does not expose FreeRTOS's task_create_static, so the kernel still
+ * allocates the stack internally on the first start; what this wrapper
+ * guarantees is that our code performs zero new/delete on start/stop and the
+ * stack is sized to the task's actual needs.
+ */
+
+/**
+ * @brief Reusable task slot with a compile-time tuned stack depth.
+ * @tparam StackDepth Stack words for the task; TASK_STACK_DEPTH_DEFAULT is
+ * 0x2000 and is far more than a lightweight polling loop needs.
+ */
+template <std::uint16_t StackDepth = TASK_STACK_DEPTH_DEFAULT>
+class StaticTask
+{
+public:
+    /**
+     * @brief Starts the task if it is not already running.
+     *
+     * @param fn Task entry point.
+     * @param arg Argument forwarded to the entry point.
+     * @param name Debug name shown in the PROS task list.
+     * @param priority Task priority (defaults to TASK_PRIORITY_DEFAULT).
+     * @return true if the task was started by this call.
+     */
+    bool start(void (*fn)(void *), void *arg, const char *name,
+               std::uint32_t priority = TASK_PRIORITY_DEFAULT)
+    {
+        if (task_.has_value())
+        {
+            return false; // Already running
+        }
+        // Placement construction into the optional's storage: no heap here
+        task_.emplace(fn, arg, priority, StackDepth, name);
+        return true;
+    }
+
+    /**
+     * @brief Stops and discards the task if it is running.
+     * @details The slot is immediately reusable by another start().
+     */
+    void stop()
+    {
+        if (task_.has_value())
+        {
+            task_->remove();
+            task_.reset();
+        }
+    }
+
+    /**
+     * @brief Whether the task is currently running.
+     */
+    bool running() const
+    {
+        return task_.has_value();
+    }
+
+    /**
+     * @brief Access to the underlying task (e.g. for suspend/resume/notify).
+     * @return Pointer to the task, or nullptr when stopped.
+     */
+    pros::Task *get()
+    {
+        return task_.has_value() ? &*task_ : nullptr;
+    }
+
+private:
+    std::optional<pros::Task> task_; // In-place task handle; empty when stopped
+};
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "pros/motors.hpp"
+#include "pros/optical.hpp"
+#include "pros/rtos.hpp"
+#include "DeviceHealth.hpp"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @file TelemetrySnapshot.hpp
+ * @brief Double-buffered device telemetry shared by all polling logic.
+ *
+ * Every smart-port read (get_actual_velocity, get_hue, ...) is an independent
+ * VDML transaction behind a port mutex. With multiple features polling the
+ * same devices, the same registers get read several times per cycle and reads
+ * from different tasks stall each other on the serial bus. Device data only
+ * refreshes every 10 ms anyway, so there is nothing to gain from reading more
+ * often than that.
+ *
+ * This layer has one collector read each device once per device-update cycle
+ * into a back buffer, then publish it with an atomic index swap. Consumers
+ * copy the published snapshot and touch zero devices on their hot paths.
+ *
+ * Device failures are absorbed here too: every read feeds a DeviceHealth
+ * tracker, a dead port is demoted to periodic reconnect probing so its read
+ * timeouts stop taxing the bus, and the snapshot carries per-device ok flags
+ * so consumers can degrade (sorter to pass-through, monitor to idle) within
+ * one collection cycle.
+ */
+
+/**
+ * @brief Value-type cache of one motor's telemetry, refreshed as a unit.
+ * @details Grouping every register the stall logic needs into one struct
+ * means one coherent sample per iteration instead of three-plus separate
+ * VDML transactions, and gives slope-based detection fields that were read
+ * in the same device-update cycle. The generation counter increments on
+ * every refresh, so a consumer holding a copy can tell whether the data it
+ * is looking at is stale.
+ */
+struct MotorState
+{
+    double velocity = 0.0;    // Actual velocity (RPM)
+    double target = 0.0;      // Commanded velocity (RPM)
+    double position = 0.0;    // Encoder position (degrees)
+    int current = 0;          // Current draw (mA)
+    double temperature = 0.0; // Motor temperature (°C)
+    uint32_t generation = 0;  // Incremented on every refresh; 0 = never sampled
+};
+
+/**
+ * @brief Scheduling-health accounting published through the snapshot.
+ * @details Filled by the watchdog so consumers (displays, match logs) can
+ * see scheduling pressure live alongside the device data.
+ */
+struct TaskHealth
+{
+    uint32_t heartbeat_misses = 0; // Deadline misses the watchdog has seen
+    uint32_t worst_gap_ms = 0;     // Longest observed heartbeat gap
+    uint32_t loop_slips = 0;       // Callback periods lost (from the scheduler)
+    uint32_t cpu_ms = 0;           // Total callback CPU time, in ms
+};
+
+/**
+ * @brief One coherent sample of every device the intake features care about.
+ * @details All fields are captured in the same collection pass, so consumers
+ * see velocity, position, and hue from the same device-update cycle.
+ */
+struct TelemetrySnapshot
+{
+    MotorState intake;         // Intake motor state, refreshed as a unit
+    TaskHealth health;         // Scheduling health, if a watchdog is attached
+    double hue = 0.0;          // Optical sensor hue (degrees); see hue_valid
+    bool hue_valid = false;    // False when the hue read was gated off (no object)
+    int proximity = 0;         // Optical sensor proximity (0-255)
+    bool intake_ok = true;     // False while the intake motor port is dead
+    bool optical_ok = true;    // False while the optical sensor port is dead
+    uint32_t timestamp_ms = 0; // pros::millis() at collection time
+};
+
+/**
+ * @brief Collects device telemetry into an atomically published snapshot.
+ *
+ * Register collectStep (a thin wrapper calling collect()) on the poll
+ * scheduler at the V5 device-update period of 10 ms. Either device may be
+ * null if a program does not use it; its fields then stay zero.
+ */
+class TelemetryCollector
+{
+public:
+    /**
+     * @brief Device-update period of the V5 brain in milliseconds.
+     * @details Collecting faster than this only rereads stale data.
+     */
+    static constexpr uint32_t COLLECT_PERIOD_MS = 10;
+
+    /**
+     * @brief Collection period (ms) while an object is inside the optical
+     * sensor window and hue bursts are armed. Matches the sensor's minimum
+     * integration time, the fastest its data can actually change.
+     */
+    static constexpr uint32_t BURST_PERIOD_MS = 3;
+
+    /**
+     * @brief Proximity reading (0-255) above which an object is considered
+     * present and the hue read is performed. Keep in sync with
+     * ColorDetector::PROXIMITY_THRESHOLD.
+     */
+    static constexpr int PROXIMITY_GATE = 100;
+
+    /**
+     * @brief Wires the collector to the devices it should sample.
+     * @param intake The intake motor, or nullptr if unused.
+     * @param optical The color sorting sensor, or nullptr if unused.
+     */
+    TelemetryCollector(pros::Motor *intake, pros::Optical *optical)
+        : intake_(intake), optical_(optical)
+    {
+    }
+
+    /**
+     * @brief Reads every device once and publishes a fresh snapshot.
+     * @details The only place in the program that touches these devices'
+     * telemetry registers. Writes go to the back buffer; the atomic index
+     * store makes the new snapshot visible to readers in one step.
+     */
+    void collect()
+    {
+        int back = 1 - front_.load(std::memory_order_relaxed);
+        TelemetrySnapshot &snap = buffers_[back];
+        uint32_t now = pros::millis();
+
+        if (intake_ != nullptr)
+        {
+            bool fresh = false;
+            if (intake_health_.shouldRead(now))
+            {
+                // The velocity read doubles as the liveness probe: PROS_ERR_F
+                // means the port did not answer
+                double velocity = intake_->get_actual_velocity();
+                bool ok = velocity != PROS_ERR_F;
+                intake_health_.recordRead(ok, now);
+                if (ok)
+                {
+                    snap.intake.velocity = velocity;
+                    snap.intake.target = intake_->get_target_velocity();
+                    snap.intake.position = intake_->get_position();
+                    snap.intake.current = intake_->get_current_draw();
+                    snap.intake.temperature = intake_->get_temperature();
+                    snap.intake.generation = ++generation_;
+                    fresh = true;
+                }
+            }
+            if (!fresh)
+            {
+                // Failed or skipped read: carry the last published state into
+                // this buffer. Leaving the back buffer untouched would publish
+                // the state from two collections ago, alternating between two
+                // generations every cycle and defeating consumers' generation
+                // dedup. Copying across freezes both buffers on the same
+                // last-good sample: stale-but-sane data, no new ingestion
+                snap.intake = buffers_[1 - back].intake;
+            }
+        }
+        if (optical_ != nullptr && optical_health_.shouldRead(now))
+        {
+            // Two-stage fusion: the cheap proximity read gates the hue read,
+            // so empty cycles (most of a match) cost one transaction, not two.
+            // It also doubles as the liveness probe.
+            int proximity = optical_->get_proximity();
+            bool ok = proximity != PROS_ERR;
+            optical_health_.recordRead(ok, now);
+            snap.proximity = ok ? proximity : 0;
+            snap.hue_valid = ok && snap.proximity >= PROXIMITY_GATE;
+            if (snap.hue_valid)
+            {
+                double hue = optical_->get_hue();
+                if (hue == PROS_ERR_F)
+                {
+                    optical_health_.recordRead(false, now);
+                    snap.hue_valid = false;
+                }
+                else
+                {
+                    snap.hue = hue;
+                }
+            }
+        }
+        else if (optical_ != nullptr)
+        {
+            // Dead sensor between probes: publish pass-through — no object,
+            // no hue — so the sorter idles instead of acting on stale reads
+            snap.proximity = 0;
+            snap.hue_valid = false;
+        }
+        snap.intake_ok = intake_health_.alive();
+        snap.optical_ok = optical_health_.alive();
+        if (health_source_ != nullptr)
+        {
+            snap.health = *health_source_;
+        }
+        snap.timestamp_ms = now;
+
+        // Publish: readers that load the index after this see the full snapshot
+        front_.store(back, std::memory_order_release);
+    }
+
+    /**
+     * @brief Attaches the watchdog's health accounting so it is published
+     * with every snapshot.
+     */
+    void setHealthSource(const TaskHealth *source)
+    {
+        health_source_ = source;
+    }
+
+    /**
+     * @brief Returns a copy of the most recently published snapshot.
+     * @details Zero device transactions; safe to call from any task. The copy
+     * is coherent as long as the reader does not lag a full collection period
+     * behind the writer mid-copy.
+     */
+    TelemetrySnapshot read() const
+    {
+        return buffers_[front_.load(std::memory_order_acquire)];
+    }
+
+    /**
+     * @brief Whether the last collection saw an object at the optical sensor.
+     * @details Use to arm burst-rate collection (BURST_PERIOD_MS) only while
+     * something is actually in front of the sensor.
+     */
+    bool objectPresent() const
+    {
+        return buffers_[front_.load(std::memory_order_acquire)].hue_valid;
+    }
+
+private:
+    pros::Motor *intake_;          // Sampled motor, or nullptr
+    pros::Optical *optical_;       // Sampled optical sensor, or nullptr
+    DeviceHealth intake_health_;   // Liveness tracking for the motor port
+    DeviceHealth optical_health_;  // Liveness tracking for the sensor port
+    const TaskHealth *health_source_ = nullptr; // Watchdog accounting, or nullptr
+    TelemetrySnapshot buffers_[2]; // Front/back snapshot buffers
+    std::atomic<int> front_{0};    // Index of the published buffer
+    uint32_t generation_ = 0;      // Collection counter for staleness checks
+};
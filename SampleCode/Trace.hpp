@@ -0,0 +1,241 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include "MotorCommandQueue.hpp" // SpscRing
+#include "StaticTask.hpp"
+#include <cstdint>
+#include <cstdio>
+
+/**
+ * @file Trace.hpp
+ * @brief Hot-path tracing: fixed-size binary events in a lock-free ring,
+ * flushed asynchronously to the SD card.
+ *
+ * When a ring gets through the sorter in a match we need to reconstruct why:
+ * was detection late, was the travel window wrong, did something block the
+ * loop? Trace points write one fixed-size binary event — timestamp from
+ * pros::micros(), event id, one argument — into a preallocated ring buffer.
+ * Recording is a couple of stores plus one atomic index update (well under
+ * 2 µs), cheap enough to leave enabled in real matches. A dedicated
+ * low-priority task drains the ring to /usd/trace.bin: SD write latency
+ * routinely spikes tens of milliseconds, so the flusher must not share the
+ * cooperative scheduler task with the control callbacks it exists to
+ * observe — a stalled flush may delay only itself.
+ *
+ * The writer side is single-producer: all shipped trace points run on the
+ * poll scheduler task. Decode the binary on a laptop by reading 16-byte
+ * little-endian records matching TraceEvent.
+ */
+
+/**
+ * @brief Event ids for the trace points shipped in this repo.
+ * @details Add ids for your own trace points after TRACE_USER_BASE.
+ */
+enum TraceId : uint16_t
+{
+    TRACE_NONE = 0,
+    TRACE_CLASSIFY = 1,        // Ring classified; arg = AllianceColor
+    TRACE_DETECT_LATENCY = 2,  // Detection complete; arg = latency in µs
+    TRACE_EJECT_QUEUED = 3,    // Wrong-color ring queued; arg = queue depth
+    TRACE_EJECT_STOP = 4,      // Intake stopped to eject; arg = ms since detection
+    TRACE_EJECT_RESUME = 5,    // Intake resumed after ejection
+    TRACE_STALL_DETECTED = 6,  // Stall signature flagged; arg = velocity (RPM)
+    TRACE_RECOVERY_START = 7,  // Recovery reversal commanded; arg = attempt
+    TRACE_RECOVERY_DONE = 8,   // Recovery finished, intake resumed
+    TRACE_RECOVERY_FAULT = 9,  // Escalation exhausted, intake stopped
+    TRACE_SCOPE = 10,          // Scoped timer exit; arg = scope duration in µs
+    TRACE_USER_BASE = 100      // First id available for user trace points
+};
+
+/**
+ * @brief One binary trace record; 16 bytes, written verbatim to the SD card.
+ */
+struct TraceEvent
+{
+    uint64_t timestamp_us; // pros::micros() at the trace point
+    uint16_t id;           // TraceId of the event
+    uint16_t scope_id;     // For TRACE_SCOPE: which scope ended; else 0
+    int32_t arg;           // Event-specific argument
+};
+
+static_assert(sizeof(TraceEvent) == 16, "TraceEvent must stay 16 bytes");
+
+/**
+ * @brief The trace recorder. All methods are static; storage is preallocated.
+ */
+class Trace
+{
+public:
+    /**
+     * @brief Events held before the flusher catches up (16 KB of RAM).
+     * @details If the ring fills, new events are dropped and counted rather
+     * than blocking the hot path.
+     */
+    static constexpr std::size_t CAPACITY = 1024;
+
+    /**
+     * @brief Period (ms) between flushes of the dedicated flush task.
+     */
+    static constexpr uint32_t FLUSH_PERIOD_MS = 100;
+
+    /**
+     * @brief Stack depth for the flush task: a drain loop and stdio buffers.
+     */
+    static constexpr uint16_t FLUSH_STACK_DEPTH = 0x800;
+
+    /**
+     * @brief Priority below default: flushing is the one job here that may
+     * block on the SD card, so everything else preempts it.
+     */
+    static constexpr uint32_t FLUSH_TASK_PRIORITY = TASK_PRIORITY_DEFAULT - 1;
+
+    /**
+     * @brief Records one event. Hot-path safe: two stores and an atomic
+     * index update, no allocation, no I/O.
+     */
+    static void event(uint16_t id, int32_t arg = 0, uint16_t scope_id = 0)
+    {
+        TraceEvent record;
+        record.timestamp_us = pros::micros();
+        record.id = id;
+        record.scope_id = scope_id;
+        record.arg = arg;
+        if (!ring().push(record))
+        {
+            dropped()++;
+        }
+    }
+
+    /**
+     * @brief Signature of an additional event consumer fed by the flusher.
+     */
+    using Sink = void (*)(const TraceEvent *events, std::size_t count);
+
+    /**
+     * @brief Registers an additional consumer (e.g. the flight recorder)
+     * that receives every drained batch alongside the SD stream.
+     */
+    static void setSink(Sink new_sink)
+    {
+        sink() = new_sink;
+    }
+
+    /**
+     * @brief Starts the dedicated flush task. Call once at startup; safe to
+     * call again (the extra call is a no-op).
+     */
+    static void startFlushTask()
+    {
+        flushTask().start(flushLoop, nullptr, "Trace Flush", FLUSH_TASK_PRIORITY);
+    }
+
+    /**
+     * @brief Drains pending events to /usd/trace.bin in one batched fwrite.
+     * @details Runs on the dedicated flush task — never register it on the
+     * poll scheduler, because it blocks on SD latency. Without an SD card
+     * the events are simply discarded.
+     */
+    static void flushStep()
+    {
+        static FILE *file = fopen("/usd/trace.bin", "wb");
+        TraceEvent batch[64];
+        std::size_t count = 0;
+        while (count < 64 && ring().pop(batch[count]))
+        {
+            count++;
+        }
+        if (count > 0)
+        {
+            if (sink() != nullptr)
+            {
+                sink()(batch, count);
+            }
+            if (file != nullptr)
+            {
+                fwrite(batch, sizeof(TraceEvent), count, file);
+                fflush(file);
+            }
+        }
+    }
+
+    /**
+     * @brief Events dropped because the ring was full; visible for telemetry.
+     */
+    static uint32_t &dropped()
+    {
+        static uint32_t count = 0;
+        return count;
+    }
+
+private:
+    /**
+     * @brief The flush task body: drain, sleep, repeat.
+     */
+    static void flushLoop(void *)
+    {
+        uint32_t now = pros::millis();
+        while (true)
+        {
+            flushStep();
+            pros::Task::delay_until(&now, FLUSH_PERIOD_MS);
+        }
+    }
+
+    /**
+     * @brief The flush task slot (function-local static: no ordering issues
+     * with global constructors).
+     */
+    static StaticTask<FLUSH_STACK_DEPTH> &flushTask()
+    {
+        static StaticTask<FLUSH_STACK_DEPTH> instance;
+        return instance;
+    }
+
+    /**
+     * @brief The preallocated event ring (function-local static: no ordering
+     * issues with global constructors).
+     */
+    static SpscRing<TraceEvent, CAPACITY> &ring()
+    {
+        static SpscRing<TraceEvent, CAPACITY> instance;
+        return instance;
+    }
+
+    /**
+     * @brief The registered additional consumer, or nullptr.
+     */
+    static Sink &sink()
+    {
+        static Sink instance = nullptr;
+        return instance;
+    }
+};
+
+/**
+ * @brief RAII scoped timer: records a TRACE_SCOPE event with the scope's
+ * duration in µs when it goes out of scope.
+ *
+ * Usage:
+ * @code
+ * { TraceScope scope(TRACE_USER_BASE + 1); expensiveWork(); }
+ * @endcode
+ */
+class TraceScope
+{
+public:
+    explicit TraceScope(uint16_t scope_id)
+        : scope_id_(scope_id), start_us_(pros::micros())
+    {
+    }
+
+    ~TraceScope()
+    {
+        Trace::event(TRACE_SCOPE,
+                     static_cast<int32_t>(pros::micros() - start_us_),
+                     scope_id_);
+    }
+
+private:
+    uint16_t scope_id_;  // Which scope this timer labels
+    uint64_t start_us_;  // Entry timestamp
+};
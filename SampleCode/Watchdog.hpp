@@ -0,0 +1,231 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include "StaticTask.hpp"
+#include "PollScheduler.hpp"
+#include "TelemetrySnapshot.hpp"
+#include <cstdint>
+
+/**
+ * @file Watchdog.hpp
+ * @brief High-priority supervisor that catches starved control loops.
+ *
+ * The priority scheme in this repo is deliberate and narrow:
+ *
+ *   TASK_PRIORITY_DEFAULT      opcontrol / autonomous and misc user code
+ *   TASK_PRIORITY_DEFAULT + 1  PollScheduler (the sensor/control callbacks)
+ *   TASK_PRIORITY_DEFAULT + 3  this watchdog
+ *
+ * The watched tasks check in by stamping a heartbeat word with pros::millis()
+ * every loop; because the watchdog outranks everything it watches, a task
+ * that stops checking in cannot also starve the code that would notice. When
+ * a heartbeat goes stale past its deadline (e.g. the scheduler — and with it
+ * the 2 ms color sort — more than 10 ms late), the watchdog counts the miss,
+ * records the worst gap, and bumps the offender one priority level to shove
+ * it past whatever default-priority code is hogging the CPU; the bump is
+ * restored once heartbeats resume, so the scheme stays flat in the steady
+ * state. Restarting the offender is deliberately not automatic: a control
+ * task restarted mid-ejection would fight its own motor state, so the fault
+ * is surfaced in the accounting and left to the operator.
+ *
+ * Per-callback CPU time and loop-slip counters come from the PollScheduler's
+ * own accounting; the watchdog aggregates them into a TaskHealth record that
+ * the telemetry collector publishes with every snapshot, so scheduling
+ * pressure is visible live next to the device data it is distorting.
+ */
+class Watchdog
+{
+public:
+    /**
+     * @brief Maximum number of supervised tasks.
+     */
+    static constexpr int MAX_TASKS = 4;
+
+    /**
+     * @brief Period (ms) of the supervision loop.
+     * @details Half the tightest deadline shipped (10 ms), so a miss is seen
+     * within one deadline of happening.
+     */
+    static constexpr uint32_t CHECK_PERIOD_MS = 5;
+
+    /**
+     * @brief Priority of the watchdog task; see the scheme in the file header.
+     */
+    static constexpr uint32_t TASK_PRIORITY = TASK_PRIORITY_DEFAULT + 3;
+
+    /**
+     * @brief Priority levels added to a starved task while its heartbeat is
+     * stale.
+     */
+    static constexpr uint32_t PRIORITY_BUMP = 1;
+
+    /**
+     * @brief Registers a task for supervision.
+     *
+     * @param name Short label for display output.
+     * @param task The task to bump when starved; may be nullptr to only count.
+     * @param deadline_ms Heartbeat age at which the task counts as starved.
+     * @return Handle to pass to heartbeatSlot, or -1 if the table is full.
+     */
+    int add(const char *name, pros::Task *task, uint32_t deadline_ms)
+    {
+        if (count_ >= MAX_TASKS)
+        {
+            return -1;
+        }
+        Entry &entry = entries_[count_];
+        entry.name = name;
+        entry.task = task;
+        entry.deadline_ms = deadline_ms;
+        entry.last_beat_ms = pros::millis();
+        entry.misses = 0;
+        entry.worst_gap_ms = 0;
+        entry.bumped = false;
+        return count_++;
+    }
+
+    /**
+     * @brief The heartbeat word a supervised task must stamp with
+     * pros::millis() every loop (hand it to PollScheduler::setHeartbeatSlot).
+     */
+    volatile uint32_t *heartbeatSlot(int handle)
+    {
+        return (handle >= 0 && handle < count_) ? &entries_[handle].last_beat_ms : nullptr;
+    }
+
+    /**
+     * @brief Attaches the scheduler whose slip and CPU accounting should be
+     * folded into the published TaskHealth record.
+     */
+    void attachScheduler(PollScheduler *scheduler)
+    {
+        scheduler_ = scheduler;
+    }
+
+    /**
+     * @brief The aggregated accounting record; hand it to
+     * TelemetryCollector::setHealthSource so it rides in every snapshot.
+     */
+    const TaskHealth &health() const
+    {
+        return health_;
+    }
+
+    /**
+     * @brief Deadline misses seen for one supervised task.
+     */
+    uint32_t missCount(int handle) const
+    {
+        return (handle >= 0 && handle < count_) ? entries_[handle].misses : 0;
+    }
+
+    /**
+     * @brief Worst heartbeat gap (ms) seen for one supervised task.
+     */
+    uint32_t worstGapMs(int handle) const
+    {
+        return (handle >= 0 && handle < count_) ? entries_[handle].worst_gap_ms : 0;
+    }
+
+    /**
+     * @brief Stack depth for the watchdog task; the loop is a handful of
+     * compares, so a small stack suffices.
+     */
+    static constexpr uint16_t STACK_DEPTH = 0x800;
+
+    /**
+     * @brief Starts the watchdog task. Call once, after the supervised tasks
+     * are registered and running.
+     */
+    void start()
+    {
+        task_.start(trampoline, this, "Watchdog", TASK_PRIORITY);
+    }
+
+private:
+    /**
+     * @brief Bookkeeping for one supervised task.
+     */
+    struct Entry
+    {
+        const char *name;                // Label for reporting
+        pros::Task *task;                // Bump target, or nullptr
+        uint32_t deadline_ms;            // Max tolerated heartbeat age
+        volatile uint32_t last_beat_ms;  // Stamped by the supervised task
+        uint32_t misses;                 // Deadline misses observed
+        uint32_t worst_gap_ms;           // Longest heartbeat gap observed
+        bool bumped;                     // Whether a priority bump is active
+    };
+
+    /**
+     * @brief pros::Task entry point; unpacks the watchdog instance.
+     */
+    static void trampoline(void *self)
+    {
+        static_cast<Watchdog *>(self)->run();
+    }
+
+    /**
+     * @brief The supervision loop: checks heartbeat ages, bumps or restores
+     * priorities, and refreshes the published accounting.
+     */
+    void run()
+    {
+        uint32_t now = pros::millis();
+        while (true)
+        {
+            uint32_t total_misses = 0;
+            uint32_t worst_gap = 0;
+            for (int i = 0; i < count_; i++)
+            {
+                Entry &entry = entries_[i];
+                uint32_t gap = pros::millis() - entry.last_beat_ms;
+                if (gap > entry.worst_gap_ms)
+                {
+                    entry.worst_gap_ms = gap;
+                }
+
+                if (gap > entry.deadline_ms)
+                {
+                    entry.misses++;
+                    if (entry.task != nullptr && !entry.bumped)
+                    {
+                        // Shove the starved task past default-priority code
+                        entry.bumped = true;
+                        entry.task->set_priority(entry.task->get_priority() + PRIORITY_BUMP);
+                    }
+                }
+                else if (entry.bumped)
+                {
+                    // Heartbeats resumed: restore the flat steady-state scheme
+                    entry.bumped = false;
+                    entry.task->set_priority(entry.task->get_priority() - PRIORITY_BUMP);
+                }
+
+                total_misses += entry.misses;
+                if (entry.worst_gap_ms > worst_gap)
+                {
+                    worst_gap = entry.worst_gap_ms;
+                }
+            }
+
+            // Fold the scheduler's per-callback accounting into the record
+            // the telemetry collector publishes
+            health_.heartbeat_misses = total_misses;
+            health_.worst_gap_ms = worst_gap;
+            if (scheduler_ != nullptr)
+            {
+                health_.loop_slips = scheduler_->totalSlips();
+                health_.cpu_ms = static_cast<uint32_t>(scheduler_->totalCpuUs() / 1000);
+            }
+
+            pros::Task::delay_until(&now, CHECK_PERIOD_MS);
+        }
+    }
+
+    Entry entries_[MAX_TASKS];            // Fixed supervision table; no heap
+    int count_ = 0;                       // Registered tasks
+    PollScheduler *scheduler_ = nullptr;  // Source of slip/CPU accounting
+    TaskHealth health_;                   // Published accounting record
+    StaticTask<STACK_DEPTH> task_;        // The watchdog task itself
+};
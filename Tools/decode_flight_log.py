@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""Decode and compare flight recorder dumps from the V5 SD card.
+
+The robot writes /usd/flight.bin when the field disables it: a flat array of
+16-byte little-endian records matching TraceEvent in SampleCode/Trace.hpp
+(uint64 timestamp_us, uint16 id, uint16 scope_id, int32 arg).
+
+Usage:
+    decode_flight_log.py flight.bin            # list events + per-id stats
+    decode_flight_log.py match1.bin match2.bin # diff two matches' timing
+
+The diff mode compares per-id event counts and inter-event timing
+distributions (median / p90 of the gaps between consecutive events of the
+same id), which is usually enough to see "detection got slower" or "we
+ejected half as often" between two matches.
+"""
+
+import struct
+import sys
+
+RECORD = struct.Struct("<QHHi")
+
+# Keep in sync with the TraceId enum in SampleCode/Trace.hpp
+TRACE_IDS = {
+    1: "CLASSIFY",
+    2: "DETECT_LATENCY",
+    3: "EJECT_QUEUED",
+    4: "EJECT_STOP",
+    5: "EJECT_RESUME",
+    6: "STALL_DETECTED",
+    7: "RECOVERY_START",
+    8: "RECOVERY_DONE",
+    9: "RECOVERY_FAULT",
+    10: "SCOPE",
+}
+
+
+def id_name(event_id):
+    if event_id in TRACE_IDS:
+        return TRACE_IDS[event_id]
+    if event_id >= 100:
+        return "USER_%d" % event_id
+    return "ID_%d" % event_id
+
+
+def load(path):
+    """Returns a list of (timestamp_us, id, scope_id, arg) tuples."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) % RECORD.size != 0:
+        sys.stderr.write(
+            "warning: %s has %d trailing bytes (truncated dump?)\n"
+            % (path, len(data) % RECORD.size)
+        )
+    return [RECORD.unpack_from(data, off)
+            for off in range(0, len(data) - RECORD.size + 1, RECORD.size)]
+
+
+def percentile(sorted_values, fraction):
+    if not sorted_values:
+        return 0.0
+    index = min(len(sorted_values) - 1, int(fraction * len(sorted_values)))
+    return sorted_values[index]
+
+
+def stats_by_id(events):
+    """Per-id: count, sorted inter-event gaps (ms), sorted args."""
+    by_id = {}
+    last_ts = {}
+    for ts, event_id, _scope, arg in events:
+        entry = by_id.setdefault(event_id, {"count": 0, "gaps_ms": [], "args": []})
+        entry["count"] += 1
+        entry["args"].append(arg)
+        if event_id in last_ts:
+            entry["gaps_ms"].append((ts - last_ts[event_id]) / 1000.0)
+        last_ts[event_id] = ts
+    for entry in by_id.values():
+        entry["gaps_ms"].sort()
+        entry["args"].sort()
+    return by_id
+
+
+def print_match(path, events):
+    if not events:
+        print("%s: empty" % path)
+        return
+    span_s = (events[-1][0] - events[0][0]) / 1e6
+    print("%s: %d events over %.1f s" % (path, len(events), span_s))
+    print("%-16s %7s %12s %12s %12s" % ("id", "count", "gap p50 ms", "gap p90 ms", "arg p50"))
+    for event_id, entry in sorted(stats_by_id(events).items()):
+        print("%-16s %7d %12.1f %12.1f %12d" % (
+            id_name(event_id),
+            entry["count"],
+            percentile(entry["gaps_ms"], 0.50),
+            percentile(entry["gaps_ms"], 0.90),
+            percentile(entry["args"], 0.50),
+        ))
+
+
+def print_diff(path_a, events_a, path_b, events_b):
+    stats_a = stats_by_id(events_a)
+    stats_b = stats_by_id(events_b)
+    print("diff: %s -> %s" % (path_a, path_b))
+    print("%-16s %8s %8s %12s %12s" % ("id", "count A", "count B", "gap p50 A", "gap p50 B"))
+    for event_id in sorted(set(stats_a) | set(stats_b)):
+        a = stats_a.get(event_id, {"count": 0, "gaps_ms": []})
+        b = stats_b.get(event_id, {"count": 0, "gaps_ms": []})
+        print("%-16s %8d %8d %11.1fms %11.1fms" % (
+            id_name(event_id),
+            a["count"], b["count"],
+            percentile(a["gaps_ms"], 0.50),
+            percentile(b["gaps_ms"], 0.50),
+        ))
+
+
+def main(argv):
+    if len(argv) == 2:
+        print_match(argv[1], load(argv[1]))
+    elif len(argv) == 3:
+        print_diff(argv[1], load(argv[1]), argv[2], load(argv[2]))
+    else:
+        sys.stderr.write(__doc__)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))